@@ -0,0 +1,710 @@
+// BC_Benchmarks.cpp
+//
+// Бенчмарки горячих путей блокчейн-системы. Результаты выводятся в формате JSON
+// (stdout или файл --output), чтобы сравнивать производительность между релизами.
+//
+// Параметры командной строки:
+//   --output FILE    записать JSON в файл вместо stdout
+//   --min-time-ms N  минимальное время измерения микробенчмарка (по умолчанию 500)
+//   --quick          сокращенный набор размеров (для быстрой проверки)
+//   --scheme NAME    схема подписи отправителя в макробенчмарках цепочки (rsa2048, ed25519, p256)
+//   --self-check     только known-answer проверка всех собранных реализаций SHA-256 (код возврата 1 при ошибке)
+
+// Системные библиотеки
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <random>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <functional>
+#include <filesystem>
+#include <stdexcept>
+#include <cstdint>
+
+// Пользовательские заголовочные файлы
+#include "BC_Block.h"
+#include "BC_Blockchain.h"
+#include "BC_Transaction.h"
+#include "BC_CryptoUtils.h"
+#include "BC_PublicKeyCache.h"
+#include "BC_RSAKeyGenerator.h"
+#include "BC_SignatureScheme.h"
+#include "BC_Sha256Lanes.h"
+#include "BC_Target.h"
+#include "BC_Utilities.h"
+#include "BC_Mempool.h"
+#include "BC_FlatStringMap.h"
+
+#include <openssl/evp.h>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    /// @brief Результат одного измерения
+    struct BenchmarkResult
+    {
+        std::string name;                           ///< Имя бенчмарка
+        std::string scheme;                         ///< Схема подписи (пусто - не применимо)
+        std::map<std::string, uint64_t> params;     ///< Параметры (размеры входа)
+        uint64_t iterations = 0;                    ///< Число выполненных операций
+        double nsPerOp = 0;                         ///< Среднее время операции, нс
+        uint64_t bytesPerOp = 0;                    ///< Объем данных на операцию (0 - не применимо)
+    };
+
+    /// @brief Подавляет вывод ConsoleUI на время измерений
+    class ScopedSilence
+    {
+    public:
+        ScopedSilence()
+            : coutBuffer(std::cout.rdbuf(nullStream.rdbuf())),
+              cerrBuffer(std::cerr.rdbuf(nullStream.rdbuf())) {}
+
+        ~ScopedSilence()
+        {
+            std::cout.rdbuf(coutBuffer);
+            std::cerr.rdbuf(cerrBuffer);
+        }
+
+    private:
+        std::ostringstream nullStream;
+        std::streambuf *coutBuffer;
+        std::streambuf *cerrBuffer;
+    };
+
+    /// @brief Пара ключей отправителя в PEM
+    struct KeyPair
+    {
+        std::string privatePEM;
+        std::string publicPEM;
+    };
+
+    KeyPair generateKeyPair(const SignatureScheme &scheme)
+    {
+        EVP_PKEY *pkey = scheme.generateKeyPair();
+        if (!pkey)
+            throw std::runtime_error(std::string("Key generation failed: ") + scheme.name());
+
+        KeyPair keys{RSAKeyGenerator::getPEMFromPrivateKey(pkey), RSAKeyGenerator::getPEMFromPublicKey(pkey)};
+        EVP_PKEY_free(pkey);
+        return keys;
+    }
+
+    /**
+     * @brief Выполняет операцию, пока не истечет минимальное время
+     * @param operation Измеряемая операция
+     * @param minTime Минимальная длительность измерения
+     * @return Число итераций и среднее время операции
+     */
+    BenchmarkResult measure(const std::function<void()> &operation, std::chrono::milliseconds minTime)
+    {
+        operation(); // Прогрев кешей и ленивой инициализации
+
+        BenchmarkResult result;
+        const auto start = Clock::now();
+        auto elapsed = Clock::duration::zero();
+        while (elapsed < minTime || result.iterations < 3)
+        {
+            operation();
+            ++result.iterations;
+            elapsed = Clock::now() - start;
+        }
+
+        result.nsPerOp = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) /
+                         static_cast<double>(result.iterations);
+        return result;
+    }
+
+    /// Сумма одного мелкого перевода (0.01 монеты)
+    constexpr Amount CENT = AmountUtils::UNITS_PER_COIN / 100;
+
+    /// @brief Подписанные переводы от Genesis_User указанным получателям
+    std::vector<Transaction> makeTransfers(const KeyPair &genesisKeys, const std::vector<std::string> &receivers,
+                                           size_t count, Amount amount)
+    {
+        std::vector<Transaction> transactions;
+        transactions.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            Transaction tx("Genesis_User", receivers[i % receivers.size()], amount);
+            tx.signTransaction(genesisKeys.privatePEM);
+            transactions.push_back(tx);
+        }
+        return transactions;
+    }
+
+    std::vector<std::string> makeAccounts(size_t count)
+    {
+        std::vector<std::string> accounts;
+        accounts.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            accounts.push_back("Bench_" + std::to_string(i));
+        }
+        return accounts;
+    }
+
+    /// @brief Цепочка с минимальной фиксированной сложностью: майнинг не доминирует в измерениях
+    ChainParams benchmarkChainParams()
+    {
+        ChainParams params;
+        params.genesisBits = Target256::POW_LIMIT_BITS;
+        params.targetSolveTimeMs = 0;
+        return params;
+    }
+
+    std::string escapeJson(const std::string &text)
+    {
+        std::string escaped;
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\')
+                escaped += '\\';
+            escaped += c;
+        }
+        return escaped;
+    }
+
+    std::string toJson(const std::vector<BenchmarkResult> &results, const SignatureScheme &chainScheme)
+    {
+        std::ostringstream json;
+        json << std::fixed << std::setprecision(2);
+        json << "{\n";
+        json << "  \"context\": {\n";
+        json << "    \"sha256_backend\": \"" << Sha256Lanes::backendName(Sha256Lanes::activeBackend()) << "\",\n";
+        json << "    \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n";
+        json << "    \"chain_signature_scheme\": \"" << chainScheme.name() << "\"\n";
+        json << "  },\n";
+        json << "  \"benchmarks\": [";
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const BenchmarkResult &result = results[i];
+            json << (i ? "," : "") << "\n    {\"name\": \"" << escapeJson(result.name) << "\", ";
+            if (!result.scheme.empty())
+            {
+                json << "\"scheme\": \"" << escapeJson(result.scheme) << "\", ";
+            }
+            json << "\"params\": {";
+
+            bool first = true;
+            for (const auto &[key, value] : result.params)
+            {
+                json << (first ? "" : ", ") << "\"" << escapeJson(key) << "\": " << value;
+                first = false;
+            }
+
+            json << "}, \"iterations\": " << result.iterations
+                 << ", \"ns_per_op\": " << result.nsPerOp
+                 << ", \"ops_per_sec\": " << (result.nsPerOp > 0 ? 1e9 / result.nsPerOp : 0);
+            if (result.bytesPerOp)
+            {
+                json << ", \"bytes_per_op\": " << result.bytesPerOp
+                     << ", \"bytes_per_sec\": " << (result.nsPerOp > 0 ? result.bytesPerOp * 1e9 / result.nsPerOp : 0);
+            }
+            json << "}";
+        }
+        json << "\n  ]\n}\n";
+        return json.str();
+    }
+
+    /// @brief Параметры запуска бенчмарков
+    struct Options
+    {
+        std::string outputPath;
+        std::chrono::milliseconds minTime{500};
+        bool quick = false;
+        bool selfCheck = false;
+        const SignatureScheme *scheme = &SignatureScheme::get(SignatureScheme::Algorithm::RSA2048);
+    };
+
+    Options parseOptions(int argc, char *argv[])
+    {
+        Options options;
+        for (int i = 1; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            if (arg == "--output" && i + 1 < argc)
+                options.outputPath = argv[++i];
+            else if (arg == "--min-time-ms" && i + 1 < argc)
+                options.minTime = std::chrono::milliseconds(std::stoul(argv[++i]));
+            else if (arg == "--quick")
+                options.quick = true;
+            else if (arg == "--self-check")
+                options.selfCheck = true;
+            else if (arg == "--scheme" && i + 1 < argc)
+            {
+                options.scheme = SignatureScheme::fromName(argv[++i]);
+                if (!options.scheme)
+                    throw std::invalid_argument("Unknown signature scheme: " + std::string(argv[i]));
+            }
+            else
+                throw std::invalid_argument("Unknown option: " + arg);
+        }
+        return options;
+    }
+
+    class BenchmarkSuite
+    {
+    public:
+        explicit BenchmarkSuite(const Options &suiteOptions)
+            : options(suiteOptions),
+              genesisKeys(generateKeyPair(*suiteOptions.scheme))
+        {
+            publicKeys.setKey("Genesis_User", genesisKeys.publicPEM);
+        }
+
+        std::vector<BenchmarkResult> run()
+        {
+            benchmarkHash();
+            benchmarkHexCodec();
+            benchmarkSignatures();
+            benchmarkBlockHash();
+            benchmarkBlockTemplate();
+            benchmarkMempool();
+            benchmarkLedgerMaps();
+            benchmarkAddBlock();
+            benchmarkChainValidation();
+            return results;
+        }
+
+    private:
+        Options options;
+        KeyPair genesisKeys;
+        PublicKeyCache publicKeys;
+        std::vector<BenchmarkResult> results;
+
+        std::vector<size_t> sizes(std::vector<size_t> full, std::vector<size_t> quick) const
+        {
+            return options.quick ? quick : full;
+        }
+
+        void record(BenchmarkResult result, const std::string &name, std::map<std::string, uint64_t> params,
+                    uint64_t bytesPerOp = 0)
+        {
+            result.name = name;
+            result.params = std::move(params);
+            result.bytesPerOp = bytesPerOp;
+            results.push_back(std::move(result));
+        }
+
+        void benchmarkHash()
+        {
+            for (size_t size : sizes({64, 1024, 16384}, {64, 1024}))
+            {
+                const std::string input(size, 'x');
+                record(measure([&]()
+                               { CryptoUtils::calculateHash(input); },
+                               options.minTime),
+                       "calculate_hash", {{"input_bytes", size}}, size);
+            }
+        }
+
+        void benchmarkHexCodec()
+        {
+            // Размер RSA-2048 подписи
+            CryptoUtils::Signature bytes(256);
+            for (size_t i = 0; i < bytes.size(); ++i)
+            {
+                bytes[i] = static_cast<unsigned char>(i * 31);
+            }
+            const std::string hex = CryptoUtils::toHex(bytes.data(), bytes.size());
+
+            record(measure([&]()
+                           { CryptoUtils::toHex(bytes.data(), bytes.size()); },
+                           options.minTime),
+                   "to_hex", {{"input_bytes", bytes.size()}}, bytes.size());
+
+            CryptoUtils::Signature decoded(bytes.size());
+            record(measure([&]()
+                           {
+                               if (!CryptoUtils::fromHex(hex, decoded.data(), decoded.size()))
+                                   throw std::runtime_error("Hex decoding failed");
+                           },
+                           options.minTime),
+                   "from_hex", {{"input_bytes", bytes.size()}}, bytes.size());
+        }
+
+        void benchmarkSignatures()
+        {
+            Transaction tx("Genesis_User", "Bench_0", AmountUtils::UNITS_PER_COIN * 3 / 2);
+            const std::string data = tx.toString();
+
+            for (SignatureScheme::Algorithm algorithm : {SignatureScheme::Algorithm::RSA2048,
+                                                         SignatureScheme::Algorithm::Ed25519,
+                                                         SignatureScheme::Algorithm::EcdsaP256})
+            {
+                const SignatureScheme &scheme = SignatureScheme::get(algorithm);
+
+                BenchmarkResult keygen = measure([&]()
+                                                 { EVP_PKEY_free(scheme.generateKeyPair()); },
+                                                 options.minTime);
+                keygen.scheme = scheme.name();
+                record(keygen, "keygen", {});
+
+                const KeyPair keys = generateKeyPair(scheme);
+                const CryptoUtils::Signature signature = CryptoUtils::signData(data, keys.privatePEM);
+                const std::map<std::string, uint64_t> params = {{"input_bytes", data.size()},
+                                                                {"signature_bytes", signature.size()}};
+
+                BenchmarkResult sign = measure([&]()
+                                               { CryptoUtils::signData(data, keys.privatePEM); },
+                                               options.minTime);
+                sign.scheme = scheme.name();
+                record(sign, "sign_data", params);
+
+                BenchmarkResult verifyPem = measure([&]()
+                                                    { CryptoUtils::verifySignature(data, signature, keys.publicPEM); },
+                                                    options.minTime);
+                verifyPem.scheme = scheme.name();
+                record(verifyPem, "verify_signature_pem", params);
+
+                const PublicKeyCache::KeyHandle publicKey = CryptoUtils::loadPublicKey(keys.publicPEM);
+                BenchmarkResult verify = measure([&]()
+                                                 {
+                                                     if (!CryptoUtils::verifySignature(data, signature, publicKey.get()))
+                                                         throw std::runtime_error("Signature verification failed");
+                                                 },
+                                                 options.minTime);
+                verify.scheme = scheme.name();
+                record(verify, "verify_signature", params);
+            }
+        }
+
+        void benchmarkBlockHash()
+        {
+            Transaction tx("Genesis_User", "Bench_0", AmountUtils::UNITS_PER_COIN * 3 / 2);
+            tx.signTransaction(genesisKeys.privatePEM);
+
+            for (size_t txCount : sizes({1, 10, 100, 1000}, {1, 100}))
+            {
+                const Block block(1, Hash256(), BlockTransactions(std::vector<Transaction>(txCount, tx)), {},
+                                  std::nullopt, Block::NewAccounts{1, {}}, Target256::POW_LIMIT_BITS, 0);
+                uint64_t nonce = 0;
+                record(measure([&]()
+                               { block.calculateBlockHashWithNonce(nonce++); },
+                               options.minTime),
+                       "block_hash_with_nonce", {{"transactions", txCount}});
+            }
+        }
+
+        void benchmarkBlockTemplate()
+        {
+            const std::vector<std::string> accounts = makeAccounts(10);
+            Blockchain blockchain(MiningScheduler::Config(), benchmarkChainParams());
+            for (const auto &account : accounts)
+            {
+                blockchain.addUser(account);
+            }
+
+            // Допуск блока без майнинга: параллельная проверка подписей и применение балансов
+            for (size_t txCount : sizes({10, 100, 1000}, {10, 100}))
+            {
+                const std::vector<Transaction> transactions = makeTransfers(genesisKeys, accounts, txCount, CENT);
+                record(measure([&]()
+                               {
+                                   if (!blockchain.createBlockTemplate(transactions, publicKeys))
+                                       throw std::runtime_error("Benchmark block template rejected");
+                               },
+                               options.minTime),
+                       "create_block_template", {{"transactions", txCount}});
+            }
+        }
+
+        void benchmarkMempool()
+        {
+            const std::vector<std::string> accounts = makeAccounts(100);
+
+            // Прием в пул и сборка шаблона с проверкой оплаты по отправителям; подписи здесь не проверяются
+            for (size_t txCount : sizes({100, 1000, 10000}, {100, 1000}))
+            {
+                std::vector<Transaction> transactions;
+                transactions.reserve(txCount);
+                for (size_t i = 0; i < txCount; ++i)
+                {
+                    transactions.emplace_back(accounts[i % accounts.size()], accounts[(i + 1) % accounts.size()], CENT);
+                }
+
+                Mempool::Config config;
+                config.maxBlockTransactions = txCount;
+                record(measure([&]()
+                               {
+                                   Mempool mempool(config);
+                                   std::string error;
+                                   for (const Transaction &tx : transactions)
+                                   {
+                                       if (!mempool.submit(tx, error))
+                                           throw std::runtime_error("Benchmark mempool rejected transaction: " + error);
+                                   }
+                                   if (mempool.takeTemplate([](const std::string &)
+                                                            { return AmountUtils::fromCoins(1000); })
+                                           .size() != txCount)
+                                       throw std::runtime_error("Benchmark mempool template is incomplete");
+                               },
+                               options.minTime),
+                       "mempool_submit_take_template", {{"transactions", txCount}});
+            }
+        }
+
+        /// @brief Поиск и обновление балансов по адресу: таблица с открытой адресацией против std::map
+        void benchmarkLedgerMaps()
+        {
+            constexpr size_t BATCH = 1024;
+
+            for (size_t accountCount : sizes({1000, 100000, 1000000}, {1000, 100000}))
+            {
+                const std::vector<std::string> accounts = makeAccounts(accountCount);
+
+                // Случайный порядок обращений, одинаковый для всех таблиц
+                std::vector<std::string> probes(BATCH);
+                std::mt19937_64 random(accountCount);
+                for (auto &probe : probes)
+                {
+                    probe = accounts[random() % accountCount];
+                }
+
+                FlatStringMap<Amount> flat(accountCount);
+                std::map<std::string, Amount> ordered;
+                std::unordered_map<std::string, Amount> unordered;
+                unordered.reserve(accountCount);
+                for (const auto &account : accounts)
+                {
+                    flat[account] = CENT;
+                    ordered[account] = CENT;
+                    unordered[account] = CENT;
+                }
+
+                const std::map<std::string, uint64_t> params = {{"accounts", accountCount}, {"batch", BATCH}};
+                Amount sink = 0;
+                record(measure([&]()
+                               {
+                                   for (const auto &probe : probes)
+                                       sink += *flat.find(probe);
+                               },
+                               options.minTime),
+                       "flat_map_lookup", params);
+                record(measure([&]()
+                               {
+                                   for (const auto &probe : probes)
+                                       sink += ordered.find(probe)->second;
+                               },
+                               options.minTime),
+                       "std_map_lookup", params);
+                record(measure([&]()
+                               {
+                                   for (const auto &probe : probes)
+                                       sink += unordered.find(probe)->second;
+                               },
+                               options.minTime),
+                       "unordered_map_lookup", params);
+
+                record(measure([&]()
+                               {
+                                   for (const auto &probe : probes)
+                                       *flat.find(probe) += 1;
+                               },
+                               options.minTime),
+                       "flat_map_update", params);
+                record(measure([&]()
+                               {
+                                   for (const auto &probe : probes)
+                                       ordered[probe] += 1;
+                               },
+                               options.minTime),
+                       "std_map_update", params);
+                record(measure([&]()
+                               {
+                                   for (const auto &probe : probes)
+                                       unordered[probe] += 1;
+                               },
+                               options.minTime),
+                       "unordered_map_update", params);
+
+                if (sink == 0)
+                    throw std::runtime_error("Benchmark ledger maps are empty");
+            }
+        }
+
+        void benchmarkAddBlock()
+        {
+            const size_t blocks = options.quick ? 5 : 20;
+            const size_t txPerBlock = 10;
+
+            for (size_t accountCount : sizes({10, 100, 1000}, {10, 100}))
+            {
+                const std::vector<std::string> accounts = makeAccounts(accountCount);
+                Blockchain blockchain(MiningScheduler::Config(), benchmarkChainParams());
+                for (const auto &account : accounts)
+                {
+                    blockchain.addUser(account);
+                }
+
+                // Пополнение всех счетов, чтобы они попадали в контрольные точки балансов
+                blockchain.addBlock(makeTransfers(genesisKeys, accounts, accountCount, AmountUtils::UNITS_PER_COIN / 2), publicKeys);
+
+                std::vector<std::vector<Transaction>> pending;
+                for (size_t i = 0; i < blocks; ++i)
+                {
+                    pending.push_back(makeTransfers(genesisKeys, accounts, txPerBlock, CENT));
+                }
+
+                // Транзакции подписаны заранее: измеряется только addBlock
+                BenchmarkResult result;
+                const auto start = Clock::now();
+                for (const auto &transactions : pending)
+                {
+                    blockchain.addBlock(transactions, publicKeys);
+                }
+                const auto elapsed = Clock::now() - start;
+
+                result.iterations = blocks;
+                result.nsPerOp = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) /
+                                 static_cast<double>(blocks);
+                record(result, "add_block", {{"accounts", accountCount}, {"transactions", txPerBlock}});
+            }
+        }
+
+        void benchmarkChainValidation()
+        {
+            const size_t txPerBlock = 4;
+            const std::vector<std::string> accounts = makeAccounts(txPerBlock);
+
+            Blockchain blockchain(MiningScheduler::Config(), benchmarkChainParams());
+            for (const auto &account : accounts)
+            {
+                blockchain.addUser(account);
+            }
+
+            // Цепочка наращивается до каждой контрольной длины, измерения идут по возрастанию
+            size_t length = 1;
+            for (size_t targetLength : sizes({10, 50, 100}, {10, 25}))
+            {
+                for (; length < targetLength; ++length)
+                {
+                    blockchain.addBlock(makeTransfers(genesisKeys, accounts, txPerBlock, CENT), publicKeys);
+                }
+
+                // Подписи из кеша допуска против полной повторной проверки
+                for (bool fullVerification : {false, true})
+                {
+                    record(measure([&]()
+                                   {
+                                       if (!blockchain.isChainValid(publicKeys, fullVerification))
+                                           throw std::runtime_error("Benchmark chain failed validation");
+                                   },
+                                   options.minTime),
+                           "is_chain_valid", {{"blocks", length},
+                                              {"transactions", blockchain.countAllTransactions()},
+                                              {"full_verification", fullVerification ? 1u : 0u}});
+                }
+
+                // Восстановление на вершине: последняя контрольная точка и приращения после нее
+                record(measure([&]()
+                               {
+                                   if (blockchain.getBalancesAtHeight(length - 1).empty())
+                                       throw std::runtime_error("Benchmark balances are empty");
+                               },
+                               options.minTime),
+                       "balances_at_height", {{"blocks", length}});
+
+                benchmarkSave(blockchain, length);
+            }
+        }
+
+        void benchmarkSave(const Blockchain &blockchain, size_t length)
+        {
+            const std::filesystem::path path = std::filesystem::temp_directory_path() / "bc_benchmark_blockchain.dat";
+            const std::string key = "benchmark-key";
+            const uint64_t plainBytes = blockchain.serialize().size();
+
+            // Тот же конвейер, что и BlockchainController::saveBlockchainToFile
+            record(measure([&]()
+                           {
+                               const std::string encrypted = PersistenceManager::encryptString(blockchain.serialize(), key);
+                               std::ofstream ofs(path, std::ios::binary);
+                               ofs.write(encrypted.data(), static_cast<std::streamsize>(encrypted.size()));
+                           },
+                           options.minTime),
+                   "save_blockchain", {{"blocks", length}}, plainBytes);
+
+            std::filesystem::remove(path);
+        }
+    };
+
+    /**
+     * @brief Known-answer проверка всех реализаций SHA-256 против OpenSSL и скалярного кода
+     * @return false, если хотя бы одна исполнимая реализация дала неверный хеш
+     * @note Реализации, не поддерживаемые процессором, пропускаются с пометкой в отчете
+     */
+    bool runSelfCheck()
+    {
+        const Sha256Lanes::Backend backends[] = {Sha256Lanes::Backend::Scalar, Sha256Lanes::Backend::SSE41,
+                                                 Sha256Lanes::Backend::AVX2, Sha256Lanes::Backend::AVX512};
+        bool passed = true;
+        for (Sha256Lanes::Backend backend : backends)
+        {
+            std::string status;
+            switch (Sha256Lanes::verifyBackend(backend))
+            {
+            case Sha256Lanes::CheckResult::Passed:
+                status = "passed";
+                break;
+            case Sha256Lanes::CheckResult::Failed:
+                status = "FAILED";
+                passed = false;
+                break;
+            case Sha256Lanes::CheckResult::NotBuilt:
+                status = "skipped (not built for this platform)";
+                break;
+            case Sha256Lanes::CheckResult::Unsupported:
+                status = "skipped (not supported by this CPU)";
+                break;
+            }
+            std::cout << "sha256 " << Sha256Lanes::backendName(backend) << " ("
+                      << Sha256Lanes::lanesOf(backend) << " lanes): " << status << "\n";
+        }
+        return passed;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    try
+    {
+        const Options options = parseOptions(argc, argv);
+        if (options.selfCheck)
+            return runSelfCheck() ? 0 : 1;
+
+        std::vector<BenchmarkResult> results;
+        {
+            ScopedSilence silence;
+            BenchmarkSuite suite(options);
+            results = suite.run();
+        }
+
+        const std::string json = toJson(results, *options.scheme);
+        if (options.outputPath.empty())
+        {
+            std::cout << json;
+        }
+        else
+        {
+            std::ofstream ofs(options.outputPath);
+            if (!ofs)
+                throw std::runtime_error("Failed to open output file: " + options.outputPath);
+            ofs << json;
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Benchmark failed: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
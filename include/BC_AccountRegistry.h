@@ -0,0 +1,64 @@
+// BC_AccountRegistry.h
+#pragma once
+
+// Системные библиотеки
+#include <string>
+#include <string_view>
+#include <deque>
+#include <shared_mutex>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+#include "BC_FlatStringMap.h"
+
+/// Плотный идентификатор счета: индекс в векторах балансов
+using AccountId = uint32_t;
+
+/**
+ * @brief Реестр счетов, назначающий адресам плотные идентификаторы.
+ *
+ * Адрес получает идентификатор при регистрации (0, 1, 2, ...) и сохраняет его
+ * навсегда, поэтому балансы хранятся в непрерывном векторе, индексируемом id,
+ * а строки адресов сравниваются только при регистрации и выводе.
+ * Потокобезопасен: чтение под разделяемой блокировкой.
+ */
+class AccountRegistry
+{
+public:
+    static constexpr AccountId NO_ACCOUNT = UINT32_MAX;    ///< Отсутствующий счет (системный отправитель)
+
+    AccountRegistry() = default;
+
+    AccountRegistry(const AccountRegistry &) = delete;
+    AccountRegistry &operator=(const AccountRegistry &) = delete;
+
+    /**
+     * @brief Возвращает идентификатор адреса, регистрируя его при необходимости
+     * @param address Адрес счета
+     * @return Идентификатор и признак того, что счет создан этим вызовом
+     */
+    std::pair<AccountId, bool> intern(std::string_view address);
+
+    /**
+     * @brief Ищет идентификатор адреса
+     * @param address Адрес счета
+     * @return Идентификатор или NO_ACCOUNT, если адрес не зарегистрирован
+     */
+    AccountId find(std::string_view address) const;
+
+    /**
+     * @brief Возвращает адрес по идентификатору
+     * @param id Идентификатор счета
+     * @return Адрес (ссылка действительна все время жизни реестра) или пустая строка для неизвестного id
+     */
+    const std::string &nameOf(AccountId id) const;
+
+    /// @brief Количество зарегистрированных счетов (следующий свободный id)
+    size_t size() const;
+
+private:
+    mutable std::shared_mutex mutex;                    ///< Синхронизация доступа
+    FlatStringMap<AccountId> ids;                       ///< Адрес -> идентификатор
+    std::deque<std::string> names;                      ///< Идентификатор -> адрес (адреса элементов стабильны)
+};
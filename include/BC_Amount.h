@@ -0,0 +1,54 @@
+// BC_Amount.h
+#pragma once
+
+// Системные библиотеки
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+/// Сумма в минимальных единицах (1 монета = AmountUtils::UNITS_PER_COIN единиц)
+using Amount = int64_t;
+
+/**
+ * @brief Операции с суммами в фиксированной точке.
+ *
+ * Балансы и суммы переводов хранятся как 64-битные целые в минимальных единицах,
+ * поэтому сложение точное, а снимки балансов сравниваются побитово. Десятичная
+ * запись разбирается и форматируется только на границе с пользователем.
+ */
+class AmountUtils
+{
+public:
+    static constexpr int DECIMALS = 8;                      ///< Знаков после запятой
+    static constexpr Amount UNITS_PER_COIN = 100000000;     ///< Единиц в одной монете
+
+    /// @brief Сумма в единицах для целого числа монет
+    static constexpr Amount fromCoins(int64_t coins) { return coins * UNITS_PER_COIN; }
+
+    /**
+     * @brief Разбирает десятичную запись суммы
+     * @param text Неотрицательное число вида "25", "25.5" или "0.00000001"
+     * @param out Сумма в минимальных единицах
+     * @return false при неверном формате, более DECIMALS знаках после запятой или переполнении
+     */
+    static bool parse(std::string_view text, Amount &out);
+
+    /**
+     * @brief Форматирует сумму в десятичную запись
+     * @param value Сумма в минимальных единицах
+     * @return Строка с DECIMALS знаками после запятой, например "35.50000000"
+     */
+    static std::string format(Amount value);
+
+    /**
+     * @brief Сложение с проверкой переполнения
+     * @return false при переполнении (result не изменяется)
+     */
+    static bool add(Amount a, Amount b, Amount &result);
+
+    /**
+     * @brief Вычитание с проверкой переполнения
+     * @return false при переполнении (result не изменяется)
+     */
+    static bool subtract(Amount a, Amount b, Amount &result);
+};
@@ -4,14 +4,22 @@
 // Системные библиотеки
 #include <string>
 #include <vector>
-#include <map>
+#include <utility>
+#include <optional>
 #include <mutex>
+#include <cstdint>
+
+#include "BC_CryptoUtils.h"
+#include "BC_Hash256.h"
+#include "BC_Amount.h"
+#include "BC_AccountRegistry.h"
+#include "BC_Utilities.h"
+#include "BC_BlockTransactions.h"
+#include "BC_MiningScheduler.h"
 
 // Forward declarations
 class Transaction;
-class CryptoUtils;
 class ConsoleUI;
-class TimeUtils;
 
 /**
  * @brief Класс-посредник для управления блокчейном.
@@ -21,53 +29,111 @@ class TimeUtils;
  */
 class Block
 {
+public:
+    /// Снимок балансов: пары (id счета, баланс), упорядоченные по id
+    using BalanceSnapshot = std::vector<std::pair<AccountId, Amount>>;
+
+    /// Изменения балансов за блок: пары (id счета, приращение), упорядоченные по id
+    using BalanceDelta = std::vector<std::pair<AccountId, Amount>>;
+
+    /// Счета, впервые появившиеся в блоке: регистрируются при его добавлении в цепочку
+    struct NewAccounts
+    {
+        AccountId firstId;                  ///< id первого адреса (размер реестра при сборке шаблона)
+        std::vector<std::string> addresses; ///< Адреса в порядке назначения id
+    };
+
 private:
     int index;                                          ///< Порядковый номер блока в цепочке
-    std::string timestamp;                              ///< Время создания блока (ISO 8601)
-    std::vector<Transaction> transactions;              ///< Список содержащихся транзакций
-    std::string previousHash;                           ///< Хеш предыдущего блока в цепочке
-    std::string hash;                                   ///< Хеш текущего блока (SHA-256)
-    int nonce;                                          ///< Число для доказательства работы
-    std::map<std::string, double> balanceSnapshot;      ///< Снимок балансов на момент создания
-    int difficulty;                                     ///< Текущая сложность майнинга
+    Timestamp timestamp;                                ///< Время создания блока (нс от эпохи)
+    BlockTransactions transactions;                     ///< Транзакции в столбцовом представлении
+    Hash256 previousHash;                               ///< Хеш предыдущего блока в цепочке
+    Hash256 hash;                                       ///< Хеш текущего блока (SHA-256)
+    uint64_t nonce;                                     ///< Число для доказательства работы
+    uint64_t extraNonce;                                ///< Расширение пространства nonce при исчерпании диапазона
+    BalanceDelta balanceDelta;                          ///< Приращения балансов счетов, затронутых блоком
+    std::optional<BalanceSnapshot> checkpoint;          ///< Полный снимок ненулевых балансов после блока
+    NewAccounts newAccounts;                            ///< Счета, регистрируемые вместе с блоком
+    uint32_t targetBits;                                ///< Цель Proof-of-Work в компактном виде
+    uint64_t parentSolveTimeMs;                         ///< Время поиска решения предыдущего блока (входит в заголовок)
+    uint64_t solveTimeMs;                               ///< Измеренное время поиска решения (не входит в заголовок)
+    bool mined;                                         ///< Решение Proof-of-Work найдено
 
 public:
     /**
-     * @brief Конструктор блока
+     * @brief Конструктор блока (шаблон без решения Proof-of-Work)
      * @param idx Индекс блока в цепочке (> 0)
      * @param prevHash Валидный хеш предыдущего блока
-     * @param txs Вектор верифицированных транзакций
-     * @param snapshot Снимок балансов кошельков
-     * @param diff Требуемое количество ведущих нулей в хеше
+     * @param txs Верифицированные транзакции, привязанные к счетам (перемещаются в блок)
+     * @param delta Приращения балансов участников блока (перемещаются в блок)
+     * @param checkpointSnapshot Все ненулевые балансы после блока (только для контрольных точек)
+     * @param accounts Адреса, получившие в блоке временные id (перемещаются в блок)
+     * @param bits Цель Proof-of-Work в компактном виде (см. Target256)
+     * @param parentSolveMs Измеренное время поиска предыдущего блока, мс (0 для генезиса)
+     * @note Майнинг не выполняется в конструкторе: используйте startMining() или mineBlock()
      */
-    Block(int idx, const std::string &prevHash,
-          const std::vector<Transaction> &txs,
-          const std::map<std::string, double> &snapshot,
-          int diff);
+    Block(int idx, const Hash256 &prevHash,
+          BlockTransactions txs,
+          BalanceDelta delta,
+          std::optional<BalanceSnapshot> checkpointSnapshot,
+          NewAccounts accounts,
+          uint32_t bits,
+          uint64_t parentSolveMs);
     
     /// @name Геттеры
     /// @{
-    const std::string &getTimestamp() const;                         ///< Время создания блока
-    const std::string &getHash() const;                              ///< Текущий хеш блока
-    const std::string &getPreviousHash() const;                      ///< Хеш предыдущего блока
-    const std::vector<Transaction> &getTransactions() const;         ///< Доступ к транзакциям
+    Timestamp getTimestamp() const;                                  ///< Время создания блока (нс от эпохи)
+    const Hash256 &getHash() const;                                  ///< Текущий хеш блока
+    const Hash256 &getPreviousHash() const;                          ///< Хеш предыдущего блока
+    const BlockTransactions &getTransactions() const;                ///< Доступ к транзакциям
     const int &getIndex() const;                                     ///< Позиция в блокчейне
-    const int &getDifficulty() const;                                ///< Сложность майнинга
-    const std::map<std::string, double> &getBalanceSnapshot() const; ///< Состояние балансов
+    const uint32_t &getTargetBits() const;                           ///< Цель майнинга (компактная)
+    const uint64_t &getSolveTimeMs() const;                          ///< Время поиска решения, мс
+    const uint64_t &getParentSolveTimeMs() const;                    ///< Время поиска предыдущего блока из заголовка, мс
+    bool isMined() const;                                            ///< Найдено ли решение
+    const BalanceDelta &getBalanceDelta() const;                     ///< Изменения балансов за блок
+    bool hasCheckpoint() const;                                      ///< Хранит ли блок полный снимок
+    const BalanceSnapshot &getCheckpoint() const;                    ///< Полный снимок (только при hasCheckpoint())
+    const NewAccounts &getNewAccounts() const;                       ///< Счета, создаваемые блоком
     /// @}
     
     /**
-     * @brief Процесс майнинга блока (Proof-of-Work)
-     * @param difficulty Требуемое количество ведущих нулей
-     * @throw std::runtime_error При ошибках майнинга
+     * @brief Запускает асинхронный майнинг блока (Proof-of-Work)
+     * @param scheduler Пул потоков, выполняющий перебор nonce
+     * @param onComplete Обработчик завершения (вызывается в рабочем потоке)
+     * @return Дескриптор задания для ожидания или отмены
+     * @warning Блок должен существовать до завершения задания
+     * @details Пространство 64-битных nonce делится между потоками на непересекающиеся
+     * диапазоны. Поток, исчерпавший свой диапазон, переходит на собственный extra-nonce.
+     */
+    MiningJob startMining(MiningScheduler &scheduler,
+                          MiningScheduler::Completion onComplete = MiningScheduler::Completion());
+
+    /**
+     * @brief Синхронный майнинг блока: startMining() с ожиданием результата
+     * @param scheduler Пул потоков, выполняющий перебор nonce
+     * @throw Исключение рабочего потока, прервавшее майнинг (остальные потоки останавливаются)
     */
-    void mineBlock(int difficulty);
+    void mineBlock(MiningScheduler &scheduler);
     
     /**
-     * @brief Вычисляет текущий хеш блока на основе приватного метода calculateBlockHashWithNonce
-     * @return HEX-строка с хешем (длиной 64 символа)
+     * @brief Вычисляет текущий хеш блока на основе calculateBlockHashWithNonce
+     * @return 32 байта SHA-256 для сравнения с целью и сохраненным хешем
     */   
-    std::string calculateBlockHash() const;
+    Hash256 calculateBlockHash() const;
+
+    /**
+     * @brief Вычисляет хеш заголовка с указанным nonce (полная сериализация, без midstate)
+     * @param testNonce Тестовое значение для подбора
+     * @return 32 байта SHA-256
+     */
+    Hash256 calculateBlockHashWithNonce(uint64_t testNonce) const;
+
+    /**
+     * @brief Сериализует полный заголовок блока с текущими extra-nonce и nonce
+     * @return Бинарный заголовок, хеш которого равен getHash() у добытого блока
+     */
+    std::string serializeHeader() const;
 
     /**
      * @brief Выводит форматированную информацию о блоке
@@ -80,10 +146,11 @@ public:
 
 private:
     /**
-     * @brief Вспомогательный метод для вычисления хеша с указанным nonce
-     * @param testNonce Тестовое значение для подбора
-     * @return Промежуточный хеш для проверки сложности
+     * @brief Сериализует часть заголовка, не зависящую от nonce
+     * @param extra Значение extra-nonce
+     * @return Бинарно: индекс, время, предыдущий хеш, цель, время поиска предыдущего блока, extra-nonce и
+     *         канонические представления всех транзакций (см. Transaction::getEncoded)
      */
-    std::string calculateBlockHashWithNonce(int testNonce) const;
+    std::string serializeHeaderPrefix(uint64_t extra) const;
 };
 
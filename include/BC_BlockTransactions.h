@@ -0,0 +1,182 @@
+// BC_BlockTransactions.h
+#pragma once
+
+// Системные библиотеки
+#include <string>
+#include <string_view>
+#include <vector>
+#include <iterator>
+#include <cstdint>
+#include <cstddef>
+
+#include "BC_Hash256.h"
+#include "BC_Amount.h"
+#include "BC_AccountRegistry.h"
+#include "BC_CryptoUtils.h"
+#include "BC_Utilities.h"
+
+// Forward declarations
+class Transaction;
+class BlockTransactions;
+
+/**
+ * @brief Невладеющее представление одной транзакции блока.
+ *
+ * Предоставляет те же геттеры, что и Transaction, но читает их из столбцов и арены
+ * BlockTransactions. Строковые поля возвращаются как string_view на арену и действительны,
+ * пока жив блок. Копирование дешевое (указатель и номер строки).
+ */
+class TransactionView
+{
+public:
+    TransactionView(const BlockTransactions &table, size_t row) : table(&table), row(row) {}
+
+    /// @{ Группа методов только для чтения
+    const Hash256 &getTxId() const;                     ///< Хеш-идентификатор транзакции
+    std::string_view getSender() const;                 ///< Адрес отправителя
+    std::string_view getReceiver() const;               ///< Адрес получателя
+    Timestamp getTimestamp() const;                     ///< Время создания (нс от эпохи)
+    std::string_view getMetadata() const;               ///< Метаданные
+    CryptoUtils::SignatureView getSignature() const;    ///< Бинарная подпись
+    AccountId getSenderId() const;                      ///< Плотный id отправителя
+    AccountId getReceiverId() const;                    ///< Плотный id получателя
+    Amount getAmount() const;                           ///< Сумма в минимальных единицах
+    std::string_view getSigningData() const;            ///< Данные, покрываемые подписью
+    std::string_view getEncoded() const;                ///< Каноническое бинарное представление
+    /// @}
+
+    /// @brief Читаемое представление (формат Transaction::toString)
+    std::string toString() const;
+
+private:
+    const BlockTransactions *table;     ///< Таблица транзакций блока
+    size_t row;                         ///< Номер транзакции в блоке
+};
+
+/**
+ * @brief Столбцовое (structure-of-arrays) хранение транзакций блока.
+ *
+ * Поля, нужные для пересчета балансов (суммы, id отправителей и получателей),
+ * лежат в отдельных непрерывных столбцах, поэтому проход по блоку - линейное
+ * чтение без разыменования указателей. Канонические представления всех транзакций
+ * (адреса, время, метаданные, подписи) записаны подряд в одну арену; для каждой
+ * строки хранятся только смещения полей внутри нее.
+ */
+class BlockTransactions
+{
+public:
+    /// @brief Прямой итератор, возвращающий TransactionView по значению
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = TransactionView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = TransactionView;
+
+        const_iterator(const BlockTransactions *table, size_t row) : table(table), row(row) {}
+
+        TransactionView operator*() const { return TransactionView(*table, row); }
+        const_iterator &operator++()
+        {
+            ++row;
+            return *this;
+        }
+        const_iterator operator++(int)
+        {
+            const_iterator previous = *this;
+            ++row;
+            return previous;
+        }
+        bool operator==(const const_iterator &other) const { return row == other.row && table == other.table; }
+
+    private:
+        const BlockTransactions *table;     ///< Таблица транзакций
+        size_t row;                         ///< Текущая строка
+    };
+
+    BlockTransactions() = default;
+
+    /**
+     * @brief Раскладывает транзакции по столбцам
+     * @param transactions Транзакции, привязанные к счетам (см. Transaction::bindAccounts)
+     */
+    explicit BlockTransactions(const std::vector<Transaction> &transactions);
+
+    /// @brief Добавляет транзакцию в конец таблицы
+    void append(const Transaction &tx);
+
+    /// @brief Количество транзакций
+    size_t size() const { return amounts.size(); }
+
+    /// @brief Нет ли транзакций
+    bool empty() const { return amounts.empty(); }
+
+    /// @brief Представление транзакции по номеру
+    TransactionView operator[](size_t row) const { return TransactionView(*this, row); }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size()); }
+
+    /// @name Столбцы для линейных проходов
+    /// @{
+    const std::vector<Amount> &getAmounts() const { return amounts; }           ///< Суммы
+    const std::vector<AccountId> &getSenderIds() const { return senderIds; }    ///< id отправителей
+    const std::vector<AccountId> &getReceiverIds() const { return receiverIds; } ///< id получателей
+    const std::vector<Hash256> &getTxIds() const { return txIds; }              ///< Идентификаторы
+    const std::vector<Timestamp> &getTimestamps() const { return timestamps; }  ///< Времена создания
+    /// @}
+
+    /**
+     * @brief Привязывает строку к счетам реестра
+     * @param row Номер строки
+     * @param sender Идентификатор отправителя (NO_ACCOUNT для системных транзакций)
+     * @param receiver Идентификатор получателя
+     * @note Идентификаторы не входят в арену, поэтому хеш блока не меняется
+     */
+    void bindAccounts(size_t row, AccountId sender, AccountId receiver)
+    {
+        senderIds[row] = sender;
+        receiverIds[row] = receiver;
+    }
+
+    /// @brief Суммарный размер канонических представлений (байт арены)
+    size_t arenaSize() const { return arena.size(); }
+
+private:
+    friend class TransactionView;
+
+    /// @brief Положение поля внутри арены
+    struct Field
+    {
+        uint32_t offset = 0;    ///< Смещение данных поля
+        uint32_t length = 0;    ///< Длина данных поля
+    };
+
+    /// @brief Смещения полей одной транзакции внутри арены
+    struct Row
+    {
+        uint32_t begin = 0;         ///< Начало канонического представления
+        uint32_t signedEnd = 0;     ///< Конец подписываемой части
+        uint32_t end = 0;           ///< Конец представления
+        Field sender;               ///< Адрес отправителя
+        Field receiver;             ///< Адрес получателя
+        Field metadata;             ///< Метаданные
+        Field signature;            ///< Подпись
+    };
+
+    std::vector<Amount> amounts;        ///< Столбец сумм
+    std::vector<AccountId> senderIds;   ///< Столбец id отправителей
+    std::vector<AccountId> receiverIds; ///< Столбец id получателей
+    std::vector<Hash256> txIds;         ///< Столбец идентификаторов
+    std::vector<Timestamp> timestamps;  ///< Столбец времен создания
+    std::vector<Row> rows;              ///< Смещения полей в арене
+    std::string arena;                  ///< Канонические представления всех транзакций подряд
+
+    /// @brief Строка арены по полю
+    std::string_view fieldView(const Field &field) const
+    {
+        return std::string_view(arena.data() + field.offset, field.length);
+    }
+};
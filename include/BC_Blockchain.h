@@ -4,17 +4,36 @@
 // Системные библиотеки
 #include <string>
 #include <vector>
-#include <map>
 #include <mutex>
+#include <memory>
+#include <unordered_set>
+#include <cstdint>
+
+#include "BC_MiningScheduler.h"
+#include "BC_Target.h"
+#include "BC_PublicKeyCache.h"
+#include "BC_ValidationPool.h"
+#include "BC_SignatureCache.h"
+#include "BC_Amount.h"
+#include "BC_AccountRegistry.h"
+#include "BC_LedgerOverlay.h"
+#include "BC_Block.h"
 
 // Forward declarations
-class Block;
 class Transaction;
 class CryptoUtils;
 class ConsoleUI;
 class TimeUtils;
 class Validator;
 
+/// @brief Параметры сложности цепочки
+struct ChainParams
+{
+    uint32_t genesisBits = Target256::GENESIS_BITS;  ///< Сложность генезис-блока (compact)
+    uint32_t targetSolveTimeMs = 1000;               ///< Целевое время поиска блока (0 - сложность не меняется)
+    uint32_t checkpointInterval = 64;                ///< Полный снимок балансов каждые N блоков (0 - только генезис)
+};
+
 /**
  * @brief Ядро блокчейн-системы, управляющее цепочкой блоков и балансами.
  * 
@@ -27,18 +46,96 @@ class Validator;
 class Blockchain
 {
 private:
-    std::vector<Block> chain;                   ///< Основная цепочка блоков
-    std::map<std::string, double> balances;     ///< Текущие балансы пользователей
-    std::mutex balanceMutex;                    ///< Синхронизация доступа к балансам
+    ChainParams params;                         ///< Параметры сложности
+    MiningScheduler miningScheduler;            ///< Пул потоков майнинга, общий для всех блоков
+    mutable ValidationPool validationPool;      ///< Пул параллельной проверки подписей
+    std::vector<std::shared_ptr<const Block>> chain; ///< Основная цепочка блоков (добытые шаблоны без копирования)
+    AccountRegistry accounts;                   ///< Плотные идентификаторы счетов
+    std::vector<Amount> balances;               ///< Текущие балансы, индексируемые AccountId
+    mutable std::mutex balanceMutex;            ///< Синхронизация доступа к балансам и цепочке
+    mutable SignatureCache signatureCache;      ///< Подписи, проверенные при допуске транзакций
+    std::unordered_set<Hash256> committedTxIds; ///< txId транзакций цепочки (защита от повтора)
 
     /// @brief Создает начальный (генезис) блок системы
-    Block createGenesisBlock();
+    std::shared_ptr<Block> createGenesisBlock();
+
+    /// @brief Подсчет транзакций без захвата мьютекса (вызывается под balanceMutex)
+    size_t countTransactionsLocked() const;
+
+    /**
+     * @brief Назначает строкам блока идентификаторы отправителей и получателей
+     * @param transactions Транзакции, прошедшие проверки без состояния
+     * @param ledger Слой блока: неизвестный получатель получает в нем временный id
+     * @details Реестр не изменяется: новые счета регистрируются в appendBlock().
+     *          Вызывается под balanceMutex.
+     */
+    void bindAccountsLocked(BlockTransactions &transactions, LedgerOverlay &ledger) const;
+
+    /**
+     * @brief Причина, по которой шаблон нельзя добавить к текущей вершине
+     * @param block Шаблон или добытый блок
+     * @return nullptr, если шаблон актуален; иначе описание (вершина или реестр счетов изменились).
+     *         Вызывается под balanceMutex.
+     */
+    const char *staleReasonLocked(const Block &block) const;
+
+    /**
+     * @brief Проверяет, что транзакции блока не повторяют цепочку и друг друга
+     * @param transactions Транзакции блока
+     * @param failedIndex Если задан, получает индекс повторной транзакции
+     * @return false при повторном txId (ошибка выводится в консоль). Вызывается под balanceMutex.
+     */
+    bool checkUniqueTxIdsLocked(const BlockTransactions &transactions, size_t *failedIndex = nullptr) const;
+
+    /**
+     * @brief Цель блока, однозначно определяемая данными заголовков
+     * @param blocks Цепочка, содержащая как минимум блоки [0, height)
+     * @param height Индекс блока, для которого вычисляется цель
+     * @param parentSolveTimeMs Время поиска блока height - 1 из заголовка блока height
+     * @return Компактная цель: genesisBits для генезиса, иначе пересчет по окну RETARGET_WINDOW
+     */
+    uint32_t expectedTargetBits(const std::vector<std::shared_ptr<const Block>> &blocks, size_t height,
+                                uint64_t parentSolveTimeMs) const;
+
+    /// @brief Результат проверки подписи транзакции при валидации цепочки
+    enum class SignatureCheck : uint8_t
+    {
+        NotApplicable,  ///< Системная транзакция или неизвестный отправитель
+        MissingKey,     ///< Нет публичного ключа отправителя
+        Cached,         ///< Подпись найдена в кеше допуска
+        Valid,          ///< Подпись проверена
+        Invalid         ///< Подпись неверна
+    };
+
+    /**
+     * @brief Проверяет подпись транзакции цепочки
+     * @param tx Транзакция блока
+     * @param publicKeys Кеш разобранных публичных ключей
+     * @param fullVerification Игнорировать кеш подписей
+     * @note Не требует balanceMutex: вызывается параллельно из пула валидации
+     */
+    SignatureCheck checkSignature(const TransactionView &tx, const PublicKeyCache &publicKeys,
+                                  bool fullVerification) const;
+
+    /// @brief Хранит ли блок с этим индексом полный снимок балансов
+    bool isCheckpointHeight(size_t height) const;
+
+    /**
+     * @brief Формирует полный снимок балансов для контрольной точки
+     * @param ledger Балансы после применения транзакций блока
+     * @param accountCount Число зарегистрированных счетов
+     * @return Счета с ненулевым балансом по возрастанию id
+     */
+    static Block::BalanceSnapshot makeCheckpoint(const LedgerOverlay &ledger, size_t accountCount);
 
 public:
     /**
      * @brief Инициализирует блокчейн с генезис-блоком
+     * @param miningConfig Параметры пула потоков майнинга
+     * @param chainParams Параметры сложности цепочки
      */
-    Blockchain();
+    explicit Blockchain(const MiningScheduler::Config &miningConfig = MiningScheduler::Config(),
+                        const ChainParams &chainParams = ChainParams());
 
     /**
      * @brief Регистрирует нового пользователя в системе
@@ -49,55 +146,151 @@ public:
 
     /**
      * @brief Возвращает последний добавленный блок
+     * @return Разделяемый указатель на вершину цепочки; блок не копируется
+     */
+    std::shared_ptr<const Block> getLatestBlock() const;
+
+    /**
+     * @brief Вычисляет цель для следующего блока
+     * @return Компактная цель, пересчитанная по среднему времени поиска последних блоков
+     * @details Блоки майнятся по запросу, поэтому интервал между ними включает простой;
+     * для стабильного времени поиска используется измеренное время майнинга каждого блока.
+     * Время поиска вершины записывается в заголовок следующего блока, поэтому проверяющий
+     * пересчитывает ту же цель (см. expectedTargetBits()).
      * @warning Не потокобезопасен - должен вызываться внутри синхронизированных блоков
-     */    
-    Block getLatestBlock() const;
+     */
+    uint32_t calculateNextTargetBits() const;
 
     /**
-     * @brief Сериализует блокчейн в читаемый текстовый формат
-     * @return Строка с полным описанием всех блоков
+     * @brief Сериализует блокчейн в бинарный формат для сохранения
+     * @return "BCHN" | версия (u8) | число блоков (u32) | для каждого блока:
+     *         заголовок с префиксом длины (включает канонические транзакции) | хеш (32 байта)
      */
     std::string serialize() const;
 
     /**
-     * @brief Проверяет валидность транзакции
+     * @brief Проверки транзакции, не зависящие от балансов
      * @param tx Проверяемая транзакция
-     * @param publicKeyPEM Публичный ключ отправителя в PEM-формате
-     * @param tempBalances Временные балансы для проверки
+     * @param publicKey Разобранный публичный ключ отправителя (nullptr - ключ не найден)
+     * @param error Причина отказа, если транзакция невалидна
      * @return true если транзакция корректна
+     *
+     * Выполняет наличие ключа и подписи, неотрицательную сумму, непустой и корректный
+     * адрес получателя и криптографическую проверку подписи. Не обращается к состоянию
+     * цепочки, поэтому вызывается параллельно для всех транзакций блока.
+     */
+    static bool verifyTransactionStateless(const Transaction &tx, EVP_PKEY *publicKey, std::string &error);
+
+    /**
+     * @brief Проверки без состояния с записью успешной подписи в кеш
+     * @param tx Проверяемая транзакция
+     * @param senderKey Ключ отправителя вместе с отпечатком
+     * @param error Причина отказа, если транзакция невалидна
+     * @return true если транзакция корректна
+     * @note Транзакция, уже допущенная с тем же ключом (например, при приеме в пул),
+     *       находится в кеше и не проверяется повторно
+     */
+    bool admitTransaction(const Transaction &tx, const PublicKeyCache::KeyEntry &senderKey, std::string &error) const;
+
+    /**
+     * @brief Применяет транзакции блока к слою поверх подтвержденных балансов
+     * @param transactions Транзакции, прошедшие verifyTransactionStateless() и привязанные к счетам
+     * @param ledger Слой записи; в него попадают отправитель и получатель каждой транзакции
+     * @param failedIndex Если задан, получает индекс первой транзакции, которую нельзя применить
+     * @return false при недостатке средств у отправителя или переполнении баланса получателя
+     * @details Линейный проход по столбцам сумм и id; при ошибке слой частично изменен и отбрасывается.
+     */
+    bool applyTransactions(const BlockTransactions &transactions, LedgerOverlay &ledger,
+                           size_t *failedIndex = nullptr) const;
+
+    /**
+     * @brief Создает шаблон следующего блока без майнинга
+     * @param transactions Вектор транзакций для включения в блок
+     * @param publicKeys Кеш разобранных публичных ключей пользователей
+     * @param rejected Если задан, получает индексы транзакций, из-за которых шаблон отклонен:
+     *                 все не прошедшие проверки без состояния, иначе первую повторную
+     *                 или неоплачиваемую. Остальные транзакции пакета можно запечатать заново.
+     * @return Шаблон блока или nullptr, если хотя бы одна транзакция невалидна
+     *
+     * Проверки без состояния выполняются параллельно в пуле валидации без блокировки,
+     * затем балансы применяются последовательно под balanceMutex.
      * 
      * Выполняет:
-     * - Проверку подписи
-     * - Валидацию форматов
-     * - Контроль баланса
+     * - Отказ для txId, уже включенных в цепочку или повторенных в пакете
+     * - Пакетную проверку транзакций относительно текущих балансов
+     * - Запись приращений балансов затронутых счетов (и полного снимка на контрольной высоте)
+     * 
+     * Балансы не изменяются до вызова appendBlock().
      */
-    bool isTransactionValid(const Transaction &tx, const std::string &publicKeyPEM, std::map<std::string, double> &tempBalances) const;
+    std::shared_ptr<Block> createBlockTemplate(const std::vector<Transaction> &transactions,
+                                               const PublicKeyCache &publicKeys,
+                                               std::vector<size_t> *rejected = nullptr);
 
     /**
-     * @brief Добавляет новый блок с транзакциями
+     * @brief Добавляет добытый блок в цепочку и применяет его транзакции к балансам
+     * @param block Блок с найденным решением Proof-of-Work
+     * @return false, если блок не добыт, устарел (вершина цепочки или реестр счетов
+     *         изменились) или повторяет транзакцию из цепочки
+     * @details Счета, впервые появившиеся в блоке, регистрируются только здесь
+     * @note Цепочка сохраняет тот же объект блока, что был добыт, без копирования
+     */
+    bool appendBlock(std::shared_ptr<const Block> block);
+
+    /**
+     * @brief Синхронно добавляет новый блок с транзакциями
      * @param transactions Вектор верифицированных транзакций
-     * @param publicKeys Соответствие пользователей и их публичных ключей
+     * @param publicKeys Кеш разобранных публичных ключей пользователей
      * 
-     * Выполняет:
-     * - Пакетную проверку транзакций
-     * - Обновление балансов
-     * - Создание снапшота системы
-     * - Майнинг нового блока
+     * Выполняет createBlockTemplate(), майнинг и appendBlock().
      */
-    void addBlock(const std::vector<Transaction> &transactions, const std::map<std::string, std::string> &publicKeys);
+    void addBlock(const std::vector<Transaction> &transactions, const PublicKeyCache &publicKeys);
+
+    /// @brief Пул потоков майнинга для асинхронных заданий
+    MiningScheduler &getMiningScheduler();
 
     /**
      * @brief Проверяет целостность всей цепочки
-     * @param publicKeys Публичные ключи всех участников
+     * @param publicKeys Кеш разобранных публичных ключей всех участников
      * @return true если все блоки и транзакции валидны
      * 
      * Проверяет:
      * - Proof-of-Work каждого блока
      * - Целостность хешей
-     * - Корректность подписей транзакций
-     * - Историческую согласованность балансов
+     * - Корректность подписей транзакций и уникальность txId
+     * - Историческую согласованность балансов: приращения каждого блока и
+     *   полные снимки контрольных точек сверяются с повторным применением транзакций
+     *
+     * Подписи, уже проверенные при допуске в блок, берутся из кеша, если совпадают
+     * txId, дайджест подписанных данных с подписью и отпечаток ключа отправителя.
      */
-    bool isChainValid(const std::map<std::string, std::string> &publicKeys) const;
+    bool isChainValid(const PublicKeyCache &publicKeys) const;
+
+    /**
+     * @brief Проверяет целостность всей цепочки
+     * @param publicKeys Кеш разобранных публичных ключей всех участников
+     * @param fullVerification Проверить все подписи заново, игнорируя кеш
+     * @return true если все блоки и транзакции валидны
+     * @details balanceMutex удерживается только на время копирования списка блоков:
+     * подписи проверяются в пуле валидации, балансы пересчитываются по неизменяемым
+     * блокам снимка, не блокируя добавление блоков и чтение балансов.
+     */
+    bool isChainValid(const PublicKeyCache &publicKeys, bool fullVerification) const;
+
+    /// @brief Реестр счетов (id для снимков балансов и транзакций)
+    const AccountRegistry &getAccountRegistry() const;
+
+    /// @brief Транзакция с таким txId уже включена в цепочку
+    bool containsTransaction(const Hash256 &txId) const;
+
+    /**
+     * @brief Устарел ли шаблон блока
+     * @return true, если вершина цепочки или реестр счетов изменились после сборки шаблона
+     *         и appendBlock() его отклонит
+     */
+    bool isTemplateStale(const Block &block) const;
+
+    /// @brief Кеш подписей, проверенных при допуске транзакций
+    const SignatureCache &getSignatureCache() const;
     
     /// @brief Возвращает общее количество транзакций в цепочке
     size_t countAllTransactions() const;
@@ -108,9 +301,19 @@ public:
     /**
      * @brief Возвращает текущий баланс пользователя
      * @param username Имя целевого пользователя
-     * @return Текущий баланс (0 если пользователь не существует)
+     * @return Текущий баланс в минимальных единицах (0 если пользователь не существует)
+     */
+    Amount getBalance(const std::string &username) const;
+
+    /**
+     * @brief Восстанавливает балансы после блока с указанным индексом
+     * @param height Индекс блока (0 - генезис)
+     * @return Балансы, индексируемые AccountId, для всех зарегистрированных счетов
+     * @throw std::out_of_range Если блока с таким индексом нет
+     * @details Берется ближайшая контрольная точка не выше height, к ней добавляются
+     * приращения последующих блоков: не более checkpointInterval блоков.
      */
-    double getBalance(const std::string &username) const;
+    std::vector<Amount> getBalancesAtHeight(size_t height) const;
     
     /// @brief Отображает ASCII-визуализацию цепочки блоков
     void drawChain() const;
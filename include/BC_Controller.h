@@ -5,11 +5,20 @@
 #include <map>
 #include <string>
 #include <vector>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <cstdint>
 
 #include "BC_Blockchain.h"
+#include "BC_Transaction.h"
+#include "BC_MiningScheduler.h"
+#include "BC_PublicKeyCache.h"
+#include "BC_Mempool.h"
 
 // Forward declarations
-class Transaction;
+class Block;
 
 /**
  * @brief Класс-посредник для управления блокчейном.
@@ -21,26 +30,62 @@ class BlockchainController
 {
 private: 
     Blockchain blockchain;                                  ///< Объект блокчейна
-    const std::map<std::string, std::string> &publicKeys;   ///< Ссылка на карту публичных ключей пользователей
+    const PublicKeyCache &publicKeys;                       ///< Ссылка на кеш разобранных публичных ключей
+
+    Mempool mempool;                                        ///< Проверенные транзакции, ожидающие блока
+
+    mutable std::mutex miningMutex;                         ///< Защита состояния майнинга ниже
+    std::condition_variable miningIdle;                     ///< Сигнал о завершении задания майнинга
+    std::shared_ptr<Block> miningTemplate;                  ///< Шаблон блока, который сейчас майнится
+    std::vector<Transaction> miningBatch;                   ///< Транзакции пула, из которых построен шаблон
+    MiningJob miningJob;                                    ///< Текущее задание майнинга
+    bool shuttingDown = false;                              ///< Контроллер уничтожается
+    std::thread sealer;                                     ///< Поток запечатывания блоков из пула
 
 public:
     /**
      * Конструктор класса BlockchainController.
-     * @param pubKeys Карта публичных ключей пользователей.
+     * @param pubKeys Кеш разобранных публичных ключей пользователей.
+     * @param miningConfig Параметры пула потоков майнинга.
+     * @param mempoolConfig Лимиты пула транзакций и запечатывания блоков.
+     */
+    BlockchainController(const PublicKeyCache &pubKeys,
+                         const MiningScheduler::Config &miningConfig = MiningScheduler::Config(),
+                         const Mempool::Config &mempoolConfig = Mempool::Config());
+
+    /**
+     * Закрывает пул, отменяет текущее задание майнинга и дожидается его завершения.
+     */
+    ~BlockchainController();
+
+    /**
+     * Проверяет подпись транзакции и помещает ее в пул.
+     * Не ждет майнинга: блок запечатывается из пула, когда набран лимит размера
+     * или истек лимит ожидания, и майнится, пока пул копит следующий блок.
+     * Потокобезопасен: может вызываться из нескольких потоков одновременно.
+     * @param tx Подписанная транзакция (перемещается в пул).
+     * @return false, если транзакция отклонена (дубликат, неверная подпись, пул заполнен).
+     */
+    bool submitTransaction(Transaction tx);
+
+    /**
+     * Запечатывает пул без ожидания лимитов и ждет, пока все транзакции будут добыты в блоки.
+     * Транзакции, которые отправители пока не могут оплатить, остаются в пуле и не ожидаются.
      */
-    BlockchainController(const std::map<std::string, std::string> &pubKeys);
+    void waitForPendingBlocks();
 
     /**
-     * Обрабатывает список транзакций: подписывает их и добавляет в новый блок.
-     * @param transactions Список транзакций для обработки.
+     * Возвращает количество транзакций, ожидающих включения в блок.
+     * @return Размер пула вместе с добываемым шаблоном.
      */
-    void processTransactions(std::vector<Transaction> transactions);
+    size_t getPendingTransactionCount() const;
 
     /**
      * Проверяет валидность блокчейна.
+     * @param fullVerification Проверить все подписи заново, не используя кеш проверенных подписей.
      * @return true, если блокчейн валиден, иначе false.
      */
-    bool isBlockchainValid() const;
+    bool isBlockchainValid(bool fullVerification = false) const;
 
     /**
      * Выводит блокчейн в консоль и отрисовывает его структуру.
@@ -56,6 +101,7 @@ public:
 
     /**
      * Регистрирует нового пользователя в блокчейне.
+     * Если добываемый шаблон из-за этого устарел, его майнинг отменяется, а транзакции возвращаются в пул.
      * @param username Имя пользователя для регистрации.
      */
     void registerUser(const std::string &username);
@@ -65,9 +111,33 @@ public:
      * @param username Имя пользователя.
      * @return Баланс пользователя.
      */
-    double getUserBalance(const std::string &username) const;
+    Amount getUserBalance(const std::string &username) const;
 
 private: 
+    /**
+     * Цикл потока запечатывания: ждет готовности пула и простоя майнинга,
+     * извлекает шаблон из пула и запускает его майнинг. Транзакции, из-за которых
+     * шаблон отклонен, удаляются из пула, а шаблон строится заново из остальных.
+     */
+    void sealLoop();
+
+    /**
+     * Запускает майнинг шаблона, построенного из пула.
+     * Вызывается под miningMutex.
+     * @param block Шаблон блока.
+     * @param batch Транзакции пула, из которых построен шаблон.
+     */
+    void startMiningLocked(std::shared_ptr<Block> block, std::vector<Transaction> batch);
+
+    /**
+     * Обрабатывает завершение задания майнинга (вызывается в потоке майнинга).
+     * Транзакции блока, не добавленного в цепочку (устаревший шаблон или отмена),
+     * возвращаются в пул и попадают в шаблон от новой вершины.
+     * @param block Добываемый блок.
+     * @param cancelled Задание было отменено.
+     */
+    void onMiningComplete(const std::shared_ptr<Block> &block, bool cancelled);
+
     /**
      * Сохраняет блокчейн в файл, шифруя его с использованием ключа.
      * @param blockchain Объект блокчейна для сохранения.
@@ -0,0 +1,61 @@
+// BC_CryptoContexts.h
+#pragma once
+
+// OpenSSL компоненты
+#include <openssl/evp.h>
+
+/**
+ * @brief Переиспользуемые контексты и алгоритмы OpenSSL.
+ *
+ * Алгоритмы (SHA-256, AES-256-CBC) извлекаются из провайдера один раз на процесс.
+ * Контексты EVP_MD_CTX / EVP_CIPHER_CTX живут по одному на поток и выдаются
+ * во временное пользование (lease): при выдаче и возврате контекст сбрасывается
+ * (reset), поэтому подпись, проверка и шифрование не выделяют память под контекст
+ * на каждый вызов, а ключи не удерживаются контекстом после операции.
+ * Вложенная выдача в том же потоке получает отдельный временный контекст.
+ */
+class CryptoContexts
+{
+public:
+    /// @brief Контекст хеширования/подписи потока на время операции
+    class DigestLease
+    {
+    public:
+        DigestLease();
+        ~DigestLease();
+
+        DigestLease(const DigestLease &) = delete;
+        DigestLease &operator=(const DigestLease &) = delete;
+
+        /// @brief Сброшенный контекст или nullptr при ошибке выделения
+        EVP_MD_CTX *get() const { return context; }
+
+    private:
+        EVP_MD_CTX *context;    ///< Выданный контекст
+        bool owned;             ///< Временный контекст (вложенная выдача), освобождается в деструкторе
+    };
+
+    /// @brief Контекст шифрования потока на время операции
+    class CipherLease
+    {
+    public:
+        CipherLease();
+        ~CipherLease();
+
+        CipherLease(const CipherLease &) = delete;
+        CipherLease &operator=(const CipherLease &) = delete;
+
+        /// @brief Сброшенный контекст или nullptr при ошибке выделения
+        EVP_CIPHER_CTX *get() const { return context; }
+
+    private:
+        EVP_CIPHER_CTX *context;    ///< Выданный контекст
+        bool owned;                 ///< Временный контекст (вложенная выдача), освобождается в деструкторе
+    };
+
+    /// @brief SHA-256, извлеченный из провайдера один раз
+    static const EVP_MD *sha256();
+
+    /// @brief AES-256-CBC, извлеченный из провайдера один раз
+    static const EVP_CIPHER *aes256Cbc();
+};
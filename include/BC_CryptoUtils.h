@@ -3,20 +3,39 @@
 
 // Системные библиотеки
 #include <string>
+#include <array>
+#include <vector>
+#include <memory>
+#include <string_view>
+#include <span>
+#include <cstddef>
+
+// OpenSSL компоненты
+#include <openssl/evp.h>
 
 /**
  * @brief Класс для криптографических операций с использованием OpenSSL.
  * 
  * Предоставляет методы для:
  * - вычисления SHA-256 хеша,
- * - подписи данных с помощью RSA приватного ключа,
- * - проверки подписи с помощью RSA публичного ключа.
+ * - подписи данных приватным ключом,
+ * - проверки подписи публичным ключом.
+ * Алгоритм подписи (RSA-2048, Ed25519, ECDSA P-256) определяется типом ключа, см. SignatureScheme.
  * 
  * @warning Для работы требуется библиотека OpenSSL.
  */
 class CryptoUtils
 {
 public:
+    /// Бинарный хеш SHA-256
+    using Digest = std::array<unsigned char, 32>;
+
+    /// Бинарная подпись (для RSA-2048 - 256 байт)
+    using Signature = std::vector<unsigned char>;
+
+    /// Невладеющее представление подписи (буфер Signature или область арены блока)
+    using SignatureView = std::span<const unsigned char>;
+
     /**
      * @brief Вычисляет SHA-256 хеш строки.
      * @param input Входные данные для хеширования.
@@ -26,27 +45,84 @@ public:
     static std::string calculateHash(const std::string &input);
 
     /**
-     * @brief Подписывает данные с использованием RSA приватного ключа.
+     * @brief Вычисляет SHA-256 хеш строки в бинарном виде.
+     * @param input Входные данные для хеширования.
+     * @return 32 байта хеша.
+     */
+    static Digest calculateDigest(const std::string &input);
+
+    /**
+     * @brief Преобразует бинарные данные в HEX-строку.
+     * @param data Указатель на данные.
+     * @param length Длина данных в байтах.
+     * @return HEX-строка в нижнем регистре (длиной 2 * length).
+     * @note Табличное кодирование, без потоков и форматирования.
+     */
+    static std::string toHex(const unsigned char *data, size_t length);
+
+    /**
+     * @brief Декодирует HEX-строку в буфер фиксированного размера.
+     * @param hex HEX-строка (регистр не важен) длиной ровно 2 * length.
+     * @param out Буфер результата.
+     * @param length Размер буфера в байтах.
+     * @return false при неверной длине или недопустимом символе.
+     * @note Табличное декодирование без ветвлений внутри цикла и без исключений.
+     */
+    static bool fromHex(std::string_view hex, unsigned char *out, size_t length);
+
+    /**
+     * @brief Декодирует HEX-строку произвольной (четной) длины.
+     * @param hex HEX-строка.
+     * @param out Результат (очищается при ошибке).
+     * @return false при нечетной длине или недопустимом символе.
+     */
+    static bool fromHex(std::string_view hex, Signature &out);
+
+    /**
+     * @brief Подписывает данные приватным ключом (схема определяется типом ключа).
      * @param data Данные для подписи.
      * @param privateKeyPEM Приватный ключ в формате PEM.
-     * @return HEX-строка с подписью.
-     * @throw std::runtime_error При ошибках:
-     * - неверный формат ключа,
-     * - ошибки OpenSSL.
+     * @return Бинарная подпись (пустая при ошибке, ошибки логируются в ConsoleUI).
      */
-    static std::string signData(const std::string &data, 
+    static Signature signData(std::string_view data, 
                             const std::string &privateKeyPEM);
 
 
         /**
-     * @brief Проверяет RSA подпись данных.
+     * @brief Проверяет подпись данных (схема определяется типом ключа).
      * @param data Исходные данные.
-     * @param signatureHex Подпись в HEX-формате.
+     * @param signature Бинарная подпись.
      * @param publicKeyPEM Публичный ключ в формате PEM.
      * @return true - подпись верна, false - ошибка проверки.
      * @note Не бросает исключения, ошибки логируются в ConsoleUI.
+     * @note Разбирает PEM при каждом вызове; для повторных проверок используйте PublicKeyCache.
      */
-    static bool verifySignature(const std::string& data,
-                            const std::string& signatureHex,
+    static bool verifySignature(std::string_view data,
+                            SignatureView signature,
                             const std::string& publicKeyPEM);
+
+    /**
+     * @brief Проверяет подпись заранее разобранным публичным ключом.
+     * @param data Исходные данные.
+     * @param signature Бинарная подпись.
+     * @param publicKey Публичный ключ (только чтение, допускается общий доступ из потоков).
+     * @return true - подпись верна, false - ошибка проверки или ключ отсутствует.
+     */
+    static bool verifySignature(std::string_view data,
+                            SignatureView signature,
+                            EVP_PKEY* publicKey);
+
+    /**
+     * @brief Разбирает публичный ключ из PEM.
+     * @param publicKeyPEM Публичный ключ в формате PEM.
+     * @return Ключ с владением (освобождается EVP_PKEY_free) или nullptr при ошибке.
+     */
+    static std::shared_ptr<EVP_PKEY> loadPublicKey(const std::string& publicKeyPEM);
+
+    /**
+     * @brief Вычисляет отпечаток публичного ключа.
+     * @param publicKey Публичный ключ.
+     * @return SHA-256 от DER-представления (SubjectPublicKeyInfo); нули при ошибке.
+     */
+    static Digest publicKeyFingerprint(EVP_PKEY* publicKey);
 };
\ No newline at end of file
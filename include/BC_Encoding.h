@@ -0,0 +1,68 @@
+// BC_Encoding.h
+#pragma once
+
+// Системные библиотеки
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Примитивы канонического бинарного кодирования.
+ *
+ * Целые числа кодируются в little-endian фиксированной ширины, байтовые строки -
+ * с 32-битным префиксом длины. Кодирование однозначно: разные наборы полей не
+ * могут дать одинаковую последовательность байт, поэтому результат пригоден для
+ * хеширования и подписи.
+ */
+class Encoding
+{
+public:
+    /// @brief Читает 32-битное значение (little-endian)
+    static uint32_t loadU32(const char *in)
+    {
+        uint32_t value = 0;
+        for (size_t i = 0; i < sizeof(value); ++i)
+        {
+            value |= static_cast<uint32_t>(static_cast<unsigned char>(in[i])) << (8 * i);
+        }
+        return value;
+    }
+
+    /// @brief Дописывает 8-битное значение
+    static void appendU8(std::string &out, uint8_t value)
+    {
+        out.push_back(static_cast<char>(value));
+    }
+
+    /// @brief Дописывает 32-битное значение (little-endian)
+    static void appendU32(std::string &out, uint32_t value)
+    {
+        for (size_t i = 0; i < sizeof(value); ++i)
+        {
+            out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+        }
+    }
+
+    /// @brief Дописывает 64-битное значение (little-endian)
+    static void appendU64(std::string &out, uint64_t value)
+    {
+        for (size_t i = 0; i < sizeof(value); ++i)
+        {
+            out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+        }
+    }
+
+    /// @brief Дописывает байтовую строку с 32-битным префиксом длины
+    static void appendBytes(std::string &out, const void *data, size_t length)
+    {
+        appendU32(out, static_cast<uint32_t>(length));
+        out.append(static_cast<const char *>(data), length);
+    }
+
+    /// @brief Дописывает строку с 32-битным префиксом длины
+    static void appendString(std::string &out, std::string_view value)
+    {
+        appendBytes(out, value.data(), value.size());
+    }
+};
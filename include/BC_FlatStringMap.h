@@ -0,0 +1,289 @@
+// BC_FlatStringMap.h
+#pragma once
+
+// Системные библиотеки
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <functional>
+#include <iterator>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Хеш-таблица с открытой адресацией и строковыми ключами.
+ *
+ * Все записи лежат в одном непрерывном массиве слотов (линейное пробирование,
+ * емкость - степень двойки, заполнение не выше 3/4). Слот хранит вычисленный
+ * один раз хеш ключа, поэтому при поиске строки сравниваются только при
+ * совпадении хешей, а при росте таблицы хеши не пересчитываются. Ключи длиной
+ * до INLINE_KEY_SIZE байт (все адреса счетов) хранятся прямо в слоте, без
+ * отдельного выделения памяти; длинные ключи - в отдельном буфере слота.
+ * Удаление сдвигает последующие записи цепочки назад, без надгробий.
+ *
+ * Порядок обхода не определен: упорядочивание выполняется только при выводе.
+ * Не потокобезопасна - синхронизация выполняется владельцем.
+ *
+ * @tparam Value Тип значения (конструируемый по умолчанию и перемещаемый)
+ */
+template <typename Value>
+class FlatStringMap
+{
+public:
+    static constexpr size_t INLINE_KEY_SIZE = 23;   ///< Максимальная длина ключа внутри слота
+    static constexpr size_t MIN_CAPACITY = 16;      ///< Емкость первого выделения
+
+    /// @brief Хеш ключа, сохраняемый в слоте (никогда не равен 0 - признаку пустого слота)
+    static uint64_t hashKey(std::string_view key)
+    {
+        const uint64_t hash = std::hash<std::string_view>{}(key);
+        return hash == EMPTY ? 1 : hash;
+    }
+
+private:
+    static constexpr uint64_t EMPTY = 0;
+
+    /// @brief Слот таблицы: хеш, ключ и значение рядом в памяти
+    struct Slot
+    {
+        uint64_t hash = EMPTY;                  ///< Хеш ключа (EMPTY - слот свободен)
+        uint32_t length = 0;                    ///< Длина ключа
+        char inlineKey[INLINE_KEY_SIZE + 1];    ///< Короткий ключ
+        std::unique_ptr<char[]> heapKey;        ///< Длинный ключ
+        Value value{};                          ///< Значение
+
+        std::string_view key() const
+        {
+            return std::string_view(length > INLINE_KEY_SIZE ? heapKey.get() : inlineKey, length);
+        }
+
+        void assignKey(std::string_view text)
+        {
+            length = static_cast<uint32_t>(text.size());
+            char *target = inlineKey;
+            if (text.size() > INLINE_KEY_SIZE)
+            {
+                heapKey = std::make_unique<char[]>(text.size());
+                target = heapKey.get();
+            }
+            std::memcpy(target, text.data(), text.size());
+        }
+    };
+
+public:
+    /// @brief Прямой итератор по занятым слотам; разыменование дает пару (ключ, ссылка на значение)
+    template <bool IsConst>
+    class Iterator
+    {
+    public:
+        using SlotPointer = std::conditional_t<IsConst, const Slot *, Slot *>;
+        using ValueReference = std::conditional_t<IsConst, const Value &, Value &>;
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::pair<std::string_view, ValueReference>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = value_type;
+
+        Iterator(SlotPointer slot, SlotPointer end) : slot(slot), end(end) { skipEmpty(); }
+
+        reference operator*() const { return reference(slot->key(), slot->value); }
+
+        Iterator &operator++()
+        {
+            ++slot;
+            skipEmpty();
+            return *this;
+        }
+
+        bool operator==(const Iterator &other) const { return slot == other.slot; }
+
+    private:
+        SlotPointer slot;
+        SlotPointer end;
+
+        void skipEmpty()
+        {
+            while (slot != end && slot->hash == EMPTY)
+                ++slot;
+        }
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    FlatStringMap() = default;
+
+    /// @brief Создает таблицу, вмещающую expected записей без роста
+    explicit FlatStringMap(size_t expected) { reserve(expected); }
+
+    FlatStringMap(FlatStringMap &&) noexcept = default;
+    FlatStringMap &operator=(FlatStringMap &&) noexcept = default;
+
+    /// @brief Копирование переносит ключи и значения в новую таблицу того же размера
+    FlatStringMap(const FlatStringMap &other)
+    {
+        reserve(other.count);
+        for (const auto &[key, value] : other)
+        {
+            *tryEmplace(key).first = value;
+        }
+    }
+
+    FlatStringMap &operator=(const FlatStringMap &other)
+    {
+        if (this != &other)
+        {
+            FlatStringMap copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Вставляет значение по умолчанию, если ключа нет
+     * @param key Ключ
+     * @return Указатель на значение (действителен до следующей вставки) и признак вставки
+     */
+    std::pair<Value *, bool> tryEmplace(std::string_view key)
+    {
+        const uint64_t hash = hashKey(key);
+        if (Slot *slot = findSlot(key, hash))
+            return {&slot->value, false};
+
+        if ((count + 1) * 4 > slots.size() * 3)
+            rehash(std::max(MIN_CAPACITY, slots.size() * 2));
+
+        Slot &slot = slots[probeFree(hash)];
+        slot.hash = hash;
+        slot.assignKey(key);
+        ++count;
+        return {&slot.value, true};
+    }
+
+    /// @brief Доступ со вставкой значения по умолчанию
+    Value &operator[](std::string_view key) { return *tryEmplace(key).first; }
+
+    /// @brief Значение по ключу или nullptr
+    Value *find(std::string_view key)
+    {
+        Slot *slot = findSlot(key, hashKey(key));
+        return slot ? &slot->value : nullptr;
+    }
+
+    /// @brief Значение по ключу или nullptr
+    const Value *find(std::string_view key) const
+    {
+        return const_cast<FlatStringMap *>(this)->find(key);
+    }
+
+    /// @brief Ключ присутствует в таблице
+    bool contains(std::string_view key) const { return find(key) != nullptr; }
+
+    /**
+     * @brief Удаляет ключ
+     * @return false, если ключа не было
+     */
+    bool erase(std::string_view key)
+    {
+        Slot *slot = findSlot(key, hashKey(key));
+        if (!slot)
+            return false;
+
+        // Сдвиг назад: запись, чей домашний слот не лежит между дырой и ней, переносится в дыру
+        const size_t mask = slots.size() - 1;
+        size_t hole = static_cast<size_t>(slot - slots.data());
+        for (size_t next = (hole + 1) & mask; slots[next].hash != EMPTY; next = (next + 1) & mask)
+        {
+            const size_t home = slots[next].hash & mask;
+            if (((next - home) & mask) >= ((next - hole) & mask))
+            {
+                slots[hole] = std::move(slots[next]);
+                hole = next;
+            }
+        }
+        slots[hole] = Slot();
+        --count;
+        return true;
+    }
+
+    /// @brief Резервирует место для expected записей
+    void reserve(size_t expected)
+    {
+        size_t capacity = MIN_CAPACITY;
+        while (capacity * 3 < expected * 4)
+            capacity *= 2;
+        if (capacity > slots.size())
+            rehash(capacity);
+    }
+
+    /// @brief Удаляет все записи, сохраняя емкость
+    void clear()
+    {
+        for (Slot &slot : slots)
+            slot = Slot();
+        count = 0;
+    }
+
+    size_t size() const { return count; }           ///< Число записей
+    bool empty() const { return count == 0; }       ///< Таблица пуста
+    size_t capacity() const { return slots.size(); } ///< Число слотов
+
+    iterator begin() { return iterator(slots.data(), slots.data() + slots.size()); }
+    iterator end() { return iterator(slots.data() + slots.size(), slots.data() + slots.size()); }
+    const_iterator begin() const { return const_iterator(slots.data(), slots.data() + slots.size()); }
+    const_iterator end() const { return const_iterator(slots.data() + slots.size(), slots.data() + slots.size()); }
+
+    /// @brief Ключи в лексикографическом порядке (для вывода)
+    std::vector<std::string_view> sortedKeys() const
+    {
+        std::vector<std::string_view> keys;
+        keys.reserve(count);
+        for (const auto &[key, value] : *this)
+            keys.push_back(key);
+        std::sort(keys.begin(), keys.end());
+        return keys;
+    }
+
+private:
+    std::vector<Slot> slots;    ///< Слоты (размер - степень двойки или 0)
+    size_t count = 0;           ///< Занятые слоты
+
+    Slot *findSlot(std::string_view key, uint64_t hash)
+    {
+        if (slots.empty())
+            return nullptr;
+
+        const size_t mask = slots.size() - 1;
+        for (size_t index = hash & mask; slots[index].hash != EMPTY; index = (index + 1) & mask)
+        {
+            Slot &slot = slots[index];
+            if (slot.hash == hash && slot.key() == key)
+                return &slot;
+        }
+        return nullptr;
+    }
+
+    size_t probeFree(uint64_t hash) const
+    {
+        const size_t mask = slots.size() - 1;
+        size_t index = hash & mask;
+        while (slots[index].hash != EMPTY)
+            index = (index + 1) & mask;
+        return index;
+    }
+
+    void rehash(size_t capacity)
+    {
+        std::vector<Slot> old(capacity);
+        old.swap(slots);
+        for (Slot &slot : old)
+        {
+            if (slot.hash != EMPTY)
+                slots[probeFree(slot.hash)] = std::move(slot);
+        }
+    }
+};
@@ -0,0 +1,87 @@
+// BC_Hash256.h
+#pragma once
+
+// Системные библиотеки
+#include <array>
+#include <string>
+#include <string_view>
+#include <ostream>
+#include <compare>
+#include <cstring>
+#include <cstddef>
+#include <functional>
+
+/**
+ * @brief 32-байтовый хеш SHA-256 как значение фиксированного размера.
+ *
+ * Используется для хешей блоков и идентификаторов транзакций вместо HEX-строк:
+ * хранится внутри объекта без выделения памяти, сравнивается побайтно
+ * (memcmp 32 байт), в HEX преобразуется только при выводе.
+ */
+class Hash256
+{
+public:
+    static constexpr size_t SIZE = 32;                      ///< Размер хеша в байтах
+    using Bytes = std::array<unsigned char, SIZE>;          ///< Бинарное представление
+
+    /// @brief Создает нулевой хеш (предыдущий хеш генезис-блока)
+    constexpr Hash256() : bytes{} {}
+
+    /// @brief Создает хеш из бинарного дайджеста
+    constexpr explicit Hash256(const Bytes &digest) : bytes(digest) {}
+
+    /**
+     * @brief Создает хеш из буфера
+     * @param digest Указатель на 32 байта
+     */
+    static Hash256 fromBytes(const unsigned char *digest)
+    {
+        Hash256 result;
+        std::memcpy(result.bytes.data(), digest, SIZE);
+        return result;
+    }
+
+    /**
+     * @brief Декодирует HEX-представление
+     * @param hex Строка из 64 HEX-символов
+     * @throw std::invalid_argument При неверной длине или символах
+     */
+    static Hash256 fromHex(std::string_view hex);
+
+    /// @brief HEX-представление в нижнем регистре (64 символа)
+    std::string toHex() const;
+
+    /// @brief Дописывает 32 байта хеша в буфер сериализации
+    void appendTo(std::string &buffer) const
+    {
+        buffer.append(reinterpret_cast<const char *>(bytes.data()), SIZE);
+    }
+
+    constexpr const unsigned char *data() const { return bytes.data(); }   ///< Байты хеша
+    static constexpr size_t size() { return SIZE; }                         ///< Размер в байтах
+    constexpr const Bytes &getBytes() const { return bytes; }               ///< Бинарное представление
+
+    /// @brief Является ли хеш нулевым
+    constexpr bool isZero() const { return *this == Hash256(); }
+
+    constexpr auto operator<=>(const Hash256 &) const = default;
+    constexpr bool operator==(const Hash256 &) const = default;
+
+private:
+    Bytes bytes;    ///< Байты хеша (порядок SHA-256)
+};
+
+/// @brief Вывод хеша в HEX
+std::ostream &operator<<(std::ostream &os, const Hash256 &hash);
+
+/// @brief Хеш для неупорядоченных контейнеров: байты SHA-256 уже равномерно распределены
+template <>
+struct std::hash<Hash256>
+{
+    size_t operator()(const Hash256 &value) const noexcept
+    {
+        size_t result;
+        std::memcpy(&result, value.data(), sizeof(result));
+        return result;
+    }
+};
@@ -2,24 +2,30 @@
 #pragma once
 
 // Системные библиотеки
-#include <map>
 #include <string>
 #include <vector>
 
+#include "BC_PublicKeyCache.h"
+#include "BC_SignatureScheme.h"
+#include "BC_FlatStringMap.h"
+
 /**
- * @brief Класс для управления RSA-ключами пользователей.
+ * @brief Класс для управления ключами подписи пользователей.
  *
- * Класс KeyManager предназначен для управления RSA-ключами пользователей.
+ * Класс KeyManager предназначен для управления ключами подписи пользователей
+ * (RSA-2048, Ed25519 или ECDSA P-256, см. SignatureScheme).
  * Он позволяет генерировать, сохранять и предоставлять доступ к публичным ключам
  * Приватный ключ сохраняется в формате PEM и удаляется из памяти.
  */
 class KeyManager
 {
 private:
-    std::map<std::string, std::string> publicKeys;  ///< Карта для хранения публичных ключей пользователей
+    FlatStringMap<std::string> publicKeys;          ///< Публичные ключи пользователей (PEM); порядок - только при выводе
+    PublicKeyCache keyCache;                        ///< Разобранные публичные ключи для проверки подписей
+    const SignatureScheme &scheme;                  ///< Схема подписи для новых ключей
 
     /**
-     * Генерирует пару RSA-ключей для указанного пользователя.
+     * Генерирует пару ключей выбранной схемы для указанного пользователя.
      * @param username Имя пользователя, для которого генерируются ключи.
      */    
     void generateAndSaveKeys(const std::string &username);
@@ -29,8 +35,10 @@ public:
      * Конструктор класса KeyManager.
      * Генерирует и сохраняет ключи для каждого пользователя из списка.
      * @param users Список пользователей, для которых нужно сгенерировать ключи.
+     * @param algorithm Схема подписи для генерируемых ключей.
      */
-    KeyManager(const std::vector<std::string> &users);
+    KeyManager(const std::vector<std::string> &users,
+               SignatureScheme::Algorithm algorithm = SignatureScheme::Algorithm::RSA2048);
 
     /**
      * Добавляет ключи для нового пользователя.
@@ -41,9 +49,17 @@ public:
 
     /**
      * Возвращает карту публичных ключей.
-     * @return Ссылка на карту публичных ключей.
+     * Ключи добавляются только через addUserKeys(), чтобы кеш разобранных ключей оставался согласованным.
+     * @return Константная ссылка на карту публичных ключей.
+     */
+    const FlatStringMap<std::string> &getPublicKeys() const;
+
+    /**
+     * Возвращает кеш разобранных публичных ключей.
+     * Обновляется при каждом добавлении ключа пользователя.
+     * @return Ссылка на кеш ключей.
      */
-    std::map<std::string, std::string> &getPublicKeys();
+    const PublicKeyCache &getPublicKeyCache() const;
 
     /**
      * Укорачивает строку ключа, оставляя только начало и конец.
@@ -0,0 +1,89 @@
+// BC_LedgerOverlay.h
+#pragma once
+
+// Системные библиотеки
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <cstddef>
+
+#include "BC_Amount.h"
+#include "BC_AccountRegistry.h"
+
+/**
+ * @brief Слой записи поверх подтвержденных балансов.
+ *
+ * Чтение берет значение из слоя, если счет уже изменен, иначе из базового вектора
+ * (счет за пределами базы имеет нулевой баланс). Запись попадает только в слой,
+ * поэтому проверка блока не копирует балансы всех счетов: стоимость растет с числом
+ * затронутых счетов. Отклоненный блок просто отбрасывает слой, принятый -
+ * переносится в базу вызовом commit().
+ *
+ * Адреса, которых еще нет в реестре, получают в слое временные id по порядку после
+ * базы. Реестр при этом не меняется: владелец регистрирует newAccounts() в том же
+ * порядке только после принятия блока.
+ *
+ * @warning Базовый вектор не должен изменяться, пока слой используется
+ */
+class LedgerOverlay
+{
+public:
+    /**
+     * @brief Создает пустой слой
+     * @param base Подтвержденные балансы, индексируемые AccountId
+     */
+    explicit LedgerOverlay(const std::vector<Amount> &base)
+        : base(&base), firstNewId(static_cast<AccountId>(base.size())) {}
+
+    /// @brief Текущий баланс счета с учетом слоя
+    Amount get(AccountId id) const
+    {
+        const auto it = writes.find(id);
+        if (it != writes.end())
+            return it->second;
+        return id < base->size() ? (*base)[id] : 0;
+    }
+
+    /// @brief Записывает баланс счета в слой
+    void set(AccountId id, Amount value) { writes[id] = value; }
+
+    /// @brief Число затронутых счетов
+    size_t size() const { return writes.size(); }
+
+    /// @brief Затронутые счета и их новые балансы по возрастанию id
+    std::vector<std::pair<AccountId, Amount>> changes() const;
+
+    /// @brief Затронутые счета и приращения их балансов относительно базы по возрастанию id
+    std::vector<std::pair<AccountId, Amount>> deltas() const;
+
+    /**
+     * @brief Переносит изменения в балансы за O(затронутых счетов)
+     * @param ledger Балансы, над которыми построен слой (расширяется при необходимости)
+     */
+    void commit(std::vector<Amount> &ledger) const;
+
+    /**
+     * @brief Назначает временный id адресу, не зарегистрированному в реестре
+     * @param address Адрес нового счета
+     * @return Идентификатор и признак того, что он выдан этим вызовом
+     */
+    std::pair<AccountId, bool> provisionalAccount(std::string_view address);
+
+    /// @brief Временный id адреса или AccountRegistry::NO_ACCOUNT
+    AccountId findProvisional(std::string_view address) const;
+
+    /// @brief Первый временный id (размер базы при создании слоя)
+    AccountId firstProvisionalId() const { return firstNewId; }
+
+    /// @brief Новые адреса в порядке выдачи временных id
+    const std::vector<std::string> &newAccounts() const { return newAddresses; }
+
+private:
+    const std::vector<Amount> *base;                ///< Подтвержденные балансы
+    std::unordered_map<AccountId, Amount> writes;   ///< Измененные счета
+    AccountId firstNewId;                           ///< id первого нового счета
+    FlatStringMap<AccountId> newIds;                ///< Новый адрес -> временный id
+    std::vector<std::string> newAddresses;          ///< Временный id - firstNewId -> адрес
+};
@@ -0,0 +1,157 @@
+// BC_Mempool.h
+#pragma once
+
+// Системные библиотеки
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstddef>
+
+#include "BC_Transaction.h"
+#include "BC_Hash256.h"
+#include "BC_Amount.h"
+
+/**
+ * @brief Пул проверенных транзакций, ожидающих включения в блок.
+ *
+ * Транзакции принимаются из любых потоков и хранятся в очередях по отправителям
+ * в порядке поступления. Шаблон блока собирается слиянием очередей по времени
+ * создания транзакций: транзакция отправителя берется, только если он может ее
+ * оплатить с учетом уже выбранных в шаблон списаний и зачислений. Повторная
+ * транзакция с тем же txId отклоняется, пока исходная в пуле или в добываемом блоке,
+ * а после добавления блока - по индексу txId цепочки (CommittedLookup).
+ *
+ * Блок запечатывается, когда в пуле набралось maxBlockTransactions транзакций
+ * или самая старая из них ждет дольше maxBlockDelayMs: одно доказательство работы
+ * и один снимок балансов приходятся на весь пакет. Транзакции, которые отправитель
+ * пока не может оплатить, остаются в очереди до зачисления средств, но не дольше
+ * maxPendingMs.
+ */
+class Mempool
+{
+public:
+    /// @brief Параметры пула и запечатывания блоков
+    struct Config
+    {
+        size_t capacity = 100000;               ///< Максимум транзакций в пуле
+        size_t maxBlockTransactions = 1000;     ///< Лимит размера блока (транзакций)
+        unsigned int maxBlockDelayMs = 2000;    ///< Лимит ожидания самой старой транзакции
+        unsigned int maxPendingMs = 60000;      ///< Срок ожидания транзакции, которую отправитель не может оплатить
+    };
+
+    /// @brief Подтвержденный баланс счета по имени (без учета пула)
+    using BalanceLookup = std::function<Amount(const std::string &address)>;
+
+    /// @brief Транзакция с таким txId уже включена в цепочку
+    using CommittedLookup = std::function<bool(const Hash256 &txId)>;
+
+    /**
+     * @brief Создает пустой пул
+     * @param config Лимиты пула; нулевой размер блока заменяется на 1
+     * @param isCommitted Индекс транзакций цепочки; вызывается под мьютексом пула
+     * @warning Шаблон должен добавляться в цепочку до вызова completeTemplate(),
+     *          иначе его txId на мгновение не известны ни пулу, ни цепочке
+     */
+    explicit Mempool(const Config &config, CommittedLookup isCommitted = CommittedLookup());
+
+    Mempool(const Mempool &) = delete;
+    Mempool &operator=(const Mempool &) = delete;
+
+    /**
+     * @brief Добавляет транзакцию в очередь ее отправителя
+     * @param tx Подписанная транзакция, прошедшая проверки без состояния
+     * @param error Причина отказа
+     * @return false для дубликата txId (в пуле или в цепочке), переполненного или закрытого пула
+     * @note Потокобезопасен: вызывается из любого числа потоков
+     */
+    bool submit(Transaction tx, std::string &error);
+
+    /// @brief Транзакция с таким txId ожидает в пуле или добывается
+    bool contains(const Hash256 &txId) const;
+
+    /**
+     * @brief Ожидает, пока пул будет готов к запечатыванию блока
+     * @return true при достижении лимита размера, лимита времени или после flush();
+     *         false после close()
+     * @note Если последний шаблон оказался пустым (ни одна транзакция не оплачивается),
+     *       ожидает новой транзакции, добавления блока или истечения maxPendingMs
+     */
+    bool waitUntilSealable();
+
+    /**
+     * @brief Извлекает транзакции для следующего блока
+     * @param balanceOf Подтвержденные балансы отправителей и получателей
+     * @return Не более maxBlockTransactions транзакций в порядке включения в блок
+     *
+     * Транзакция, которую отправитель не может оплатить, откладывается вместе со
+     * следующими транзакциями этого отправителя и остается в пуле до зачисления
+     * средств следующими блоками. Удаляется только неоплачиваемая транзакция,
+     * ожидающая дольше maxPendingMs.
+     * Идентификаторы извлеченных транзакций остаются занятыми до completeTemplate().
+     */
+    std::vector<Transaction> takeTemplate(const BalanceLookup &balanceOf);
+
+    /// @brief Освобождает txId транзакций последнего шаблона (блок добавлен в цепочку)
+    void completeTemplate();
+
+    /**
+     * @brief Возвращает транзакции шаблона, не попавшего в цепочку, в начало очередей их отправителей
+     * @param batch Транзакции, извлеченные takeTemplate(), в порядке включения в блок
+     *
+     * Шаблон устаревает, если вершина цепочки или реестр счетов изменились во время майнинга.
+     * Возвращенные транзакции сохраняют свои txId и запечатываются без ожидания лимита времени.
+     */
+    void returnTemplate(std::vector<Transaction> batch);
+
+    /**
+     * @brief Удаляет из последнего шаблона транзакции, отклоненные при его построении
+     * @param txIds Идентификаторы отклоненных транзакций; они снова могут быть отправлены
+     */
+    void evict(const std::vector<Hash256> &txIds);
+
+    /// @brief Запечатать блок сразу, не дожидаясь лимитов (до опустошения пула; для пустого пула не действует)
+    void flush();
+
+    /// @brief Закрывает пул: новые транзакции отклоняются, ожидание прерывается
+    void close();
+
+    /// @brief Число транзакций в пуле и в добываемом шаблоне
+    size_t size() const;
+
+    /// @brief Нет добываемого шаблона, а в пуле остались только неоплачиваемые транзакции (или ничего)
+    bool isSettled() const;
+
+    /// @brief Текущие лимиты
+    const Config &getConfig() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /// @brief Транзакция в очереди отправителя
+    struct Entry
+    {
+        Transaction tx;             ///< Транзакция
+        Clock::time_point arrival;  ///< Момент поступления в пул
+    };
+
+    Config config;                                                  ///< Лимиты пула
+    CommittedLookup isCommitted;                                    ///< Индекс txId цепочки (может быть пустым)
+    mutable std::mutex mutex;                                       ///< Защита полей ниже
+    std::condition_variable changed;                                ///< Сигнал о новых транзакциях, flush и close
+    std::unordered_map<std::string, std::deque<Entry>> senders;     ///< Очереди по отправителям
+    std::unordered_set<Hash256> known;                              ///< txId в пуле и в шаблоне
+    std::vector<Hash256> inFlight;                                  ///< txId добываемого шаблона
+    size_t queued = 0;                                              ///< Транзакций в очередях
+    bool sealRequested = false;                                     ///< Вызван flush()
+    bool stalled = false;                                           ///< Ни одна транзакция пула не оплачивается
+    bool closed = false;                                            ///< Вызван close()
+
+    /// @brief Время поступления самой старой транзакции (вызывается под mutex, queued > 0)
+    Clock::time_point oldestArrivalLocked() const;
+};
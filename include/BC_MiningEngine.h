@@ -0,0 +1,73 @@
+// BC_MiningEngine.h
+#pragma once
+
+// Системные библиотеки
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+#include "BC_Sha256Lanes.h"
+
+/**
+ * @brief Движок хеширования для Proof-of-Work с кешированием midstate SHA-256.
+ *
+ * Заголовок блока делится на две части:
+ * - префикс, не зависящий от nonce (индекс, время, предыдущий хеш, транзакции),
+ * - суффикс из 8 байт nonce (little-endian).
+ *
+ * Префикс сериализуется и прогоняется через SHA-256 один раз при создании движка.
+ * Каждая попытка майнинга начинает с сохраненного состояния (midstate) и хеширует
+ * только суффикс, поэтому скорость перебора не зависит от числа транзакций в блоке.
+ * Пакетный режим хеширует сразу несколько nonce через SIMD-реализацию Sha256Lanes.
+ *
+ * Реализация Sha256Lanes и ширина пакета фиксируются при создании движка, поэтому
+ * selectBackend() во время майнинга не меняет batchSize() уже созданных движков.
+ *
+ * @note Все методы потокобезопасны: после создания движок только читается.
+ */
+class MiningEngine
+{
+private:
+    Sha256Lanes::Midstate midstate;     ///< Состояние SHA-256 после обработки префикса
+    Sha256Lanes::Backend backend;       ///< Реализация пакетного хеширования
+
+public:
+    /// Размер суффикса nonce в байтах
+    static constexpr size_t NONCE_SIZE = Sha256Lanes::NONCE_SIZE;
+
+    /**
+     * @brief Создает движок и вычисляет midstate для префикса заголовка
+     * @param headerPrefix Сериализованная часть заголовка без nonce
+     * @param lanesBackend Реализация пакетного хеширования (по умолчанию активная)
+     */
+    explicit MiningEngine(const std::string &headerPrefix,
+                          Sha256Lanes::Backend lanesBackend = Sha256Lanes::activeBackend());
+
+    /**
+     * @brief Вычисляет хеш заголовка для заданного nonce
+     * @param nonce Проверяемое значение
+     * @return HEX-строка с хешем (длиной 64 символа)
+     */
+    std::string hashWithNonce(uint64_t nonce) const;
+
+    /// @brief Количество nonce, обрабатываемых за один вызов hashBatch
+    size_t batchSize() const;
+
+    /// @brief Реализация, зафиксированная при создании
+    Sha256Lanes::Backend getBackend() const;
+
+    /**
+     * @brief Хеширует batchSize() последовательных nonce за один проход
+     * @param firstNonce Первый nonce пакета
+     * @param digests Буфер на batchSize() * Sha256Lanes::DIGEST_SIZE байт
+     */
+    void hashBatch(uint64_t firstNonce, unsigned char *digests) const;
+
+    /**
+     * @brief Дописывает nonce к сериализованному заголовку в каноническом виде
+     * @param out Строка-приемник (обычно префикс заголовка)
+     * @param nonce Значение nonce
+     * @note Используется при одноразовом хешировании, чтобы результат совпадал с hashWithNonce
+     */
+    static void appendNonce(std::string &out, uint64_t nonce);
+};
@@ -0,0 +1,178 @@
+// BC_MiningScheduler.h
+#pragma once
+
+// Системные библиотеки
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <cstdint>
+
+// Пользовательские заголовки
+#include "BC_MiningTelemetry.h"
+
+// Forward declarations
+struct MiningJobState;
+
+/**
+ * @brief Дескриптор асинхронного задания майнинга.
+ *
+ * Возвращается MiningScheduler::submit. Позволяет дождаться завершения задания
+ * или отменить его. Копии дескриптора ссылаются на одно и то же задание.
+ */
+class MiningJob
+{
+public:
+    /// @brief Пустой дескриптор (не связан с заданием)
+    MiningJob() = default;
+
+    /// @brief Ожидает завершения задания (включая обработчик завершения)
+    void wait() const;
+
+    /**
+     * @brief Ожидает завершения задания не дольше timeout
+     * @return true, если задание завершено
+     */
+    bool waitFor(std::chrono::milliseconds timeout) const;
+
+    /**
+     * @brief Запрашивает отмену задания
+     * @note Не блокирует: рабочие потоки выходят из перебора при следующей проверке флага
+     */
+    void cancel();
+
+    /**
+     * @brief Отменяет задание, результат которого устарел (вершина цепочки или реестр счетов изменились)
+     * @note Такие задания учитываются в телеметрии как устаревшие; cancel() их не учитывает
+     */
+    void cancelStale();
+
+    /// @brief Завершено ли задание
+    bool isDone() const;
+
+    /// @brief Была ли запрошена отмена
+    bool isCancelled() const;
+
+    /**
+     * @brief Исключение, прервавшее задание
+     * @return Первое исключение рабочего потока или nullptr; задание с ошибкой отменяется
+     */
+    std::exception_ptr getError() const;
+
+    /// @brief Связан ли дескриптор с заданием
+    bool isValid() const;
+
+private:
+    friend class MiningScheduler;
+    std::shared_ptr<MiningJobState> state;  ///< Общее состояние задания
+
+    explicit MiningJob(std::shared_ptr<MiningJobState> jobState);
+};
+
+/**
+ * @brief Долгоживущий пул потоков майнинга, переиспользуемый между блоками.
+ *
+ * Потоки создаются один раз при создании планировщика и паркуются на условной
+ * переменной между заданиями. Блок передается в пул как задание: каждый рабочий
+ * поток вызывает функцию задания со своим индексом. Задания выполняются по очереди;
+ * submit() не блокирует вызывающего и возвращает дескриптор MiningJob.
+ *
+ * Оператор может ограничить число потоков и зарезервировать ядра под валидацию:
+ * потоки майнинга (опционально) закрепляются за ядрами, следующими за зарезервированными.
+ */
+class MiningScheduler
+{
+public:
+    /// @brief Параметры пула майнинга
+    struct Config
+    {
+        unsigned int workerCount = 0;       ///< Число потоков (0 - все ядра, кроме зарезервированных)
+        unsigned int reservedCores = 0;     ///< Ядра, оставляемые для валидации
+        bool pinThreads = false;            ///< Закреплять потоки за ядрами (CPU affinity)
+        unsigned int statsIntervalMs = 0;   ///< Период итоговой строки телеметрии (0 - не печатать)
+    };
+
+    /**
+     * @brief Функция задания майнинга
+     * @param workerIndex Индекс рабочего потока [0, workerCount)
+     * @param workerCount Общее число рабочих потоков
+     * @param cancelled Флаг отмены, который задание должно периодически проверять
+     */
+    using Task = std::function<void(unsigned int workerIndex, unsigned int workerCount,
+                                    const std::atomic<bool> &cancelled)>;
+
+    /**
+     * @brief Обработчик завершения задания
+     * @param cancelled true, если задание было отменено (в том числе из-за исключения в рабочем потоке)
+     * @note Вызывается в рабочем потоке до того, как ожидающие wait() будут разбужены
+     */
+    using Completion = std::function<void(bool cancelled)>;
+
+    /**
+     * @brief Создает пул и запускает рабочие потоки
+     * @param config Параметры пула
+     */
+    explicit MiningScheduler(const Config &config);
+
+    /**
+     * @brief Отменяет незавершенные задания, останавливает и присоединяет рабочие потоки
+     * @note Обработчик завершения вызывается с cancelled = true и для заданий, не успевших выполниться
+     */
+    ~MiningScheduler();
+
+    MiningScheduler(const MiningScheduler &) = delete;
+    MiningScheduler &operator=(const MiningScheduler &) = delete;
+
+    /**
+     * @brief Ставит задание в очередь без ожидания
+     * @param task Функция задания
+     * @param onComplete Обработчик завершения (может быть пустым)
+     * @return Дескриптор для ожидания или отмены
+     */
+    MiningJob submit(Task task, Completion onComplete = Completion());
+
+    /**
+     * @brief Выполняет задание на всех рабочих потоках и ждет его завершения
+     * @param task Функция задания (должна сама завершаться, когда решение найдено)
+     */
+    void run(const Task &task);
+
+    /// @brief Количество рабочих потоков
+    unsigned int getWorkerCount() const;
+
+    /// @brief Фактические параметры пула (workerCount уже вычислен)
+    const Config &getConfig() const;
+
+    /// @brief Телеметрия скорости хеширования рабочих потоков
+    MiningTelemetry &getTelemetry();
+
+    /**
+     * @brief Закрепляет поток за ядром
+     * @return false, если платформа не поддерживает закрепление или вызов завершился ошибкой
+     */
+    static bool pinToCore(std::thread &thread, unsigned int core);
+
+private:
+    Config config;                                          ///< Параметры пула
+    std::unique_ptr<MiningTelemetry> telemetry;             ///< Счетчики хешей и сэмплер
+    std::vector<std::thread> workers;                       ///< Рабочие потоки
+
+    std::mutex stateMutex;                                  ///< Защита очереди и состояния ниже
+    std::condition_variable jobReady;                       ///< Сигнал потокам о новом задании
+    std::deque<std::shared_ptr<MiningJobState>> queue;      ///< Очередь заданий; первое - текущее
+    uint64_t generation = 0;                                ///< Номер текущего задания
+    unsigned int pendingWorkers = 0;                        ///< Потоки, еще выполняющие текущее задание
+    bool stopping = false;                                  ///< Флаг остановки пула
+
+    /// @brief Цикл рабочего потока: ожидание задания, выполнение, парковка
+    void workerLoop(unsigned int workerIndex);
+
+    /// @brief Делает первое задание очереди текущим (вызывается под stateMutex)
+    void startNextJob();
+};
@@ -0,0 +1,102 @@
+// BC_MiningTelemetry.h
+#pragma once
+
+// Системные библиотеки
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief Телеметрия майнинга без блокировок в горячем цикле.
+ *
+ * Каждый рабочий поток увеличивает только свой счетчик хешей (отдельная кеш-линия,
+ * relaxed-запись без RMW), поэтому учет не сериализует потоки. Отдельный поток-сэмплер
+ * периодически снимает счетчики, вычисляет скорость по потокам и суммарно и при
+ * необходимости печатает итоговую строку. Результаты доступны через snapshot().
+ */
+class MiningTelemetry
+{
+public:
+    /// @brief Снимок метрик на момент последнего опроса
+    struct Snapshot
+    {
+        std::vector<double> threadHashRates;    ///< Скорость каждого потока, хеш/с
+        double totalHashRate = 0;               ///< Суммарная скорость, хеш/с
+        uint64_t totalHashes = 0;               ///< Всего хешей с момента запуска
+        uint64_t blocksSolved = 0;              ///< Найдено решений
+        uint64_t staleJobs = 0;                 ///< Заданий, отмененных из-за смены вершины или реестра счетов
+        uint64_t lastSolveTimeMs = 0;           ///< Время поиска последнего решения, мс
+        double averageSolveTimeMs = 0;          ///< Среднее время поиска решения, мс
+    };
+
+    /**
+     * @brief Создает счетчики и запускает поток-сэмплер
+     * @param workerCount Количество рабочих потоков майнинга
+     * @param sampleInterval Период опроса счетчиков
+     * @param printSummary Печатать итоговую строку после каждого опроса с новыми хешами
+     */
+    MiningTelemetry(unsigned int workerCount, std::chrono::milliseconds sampleInterval, bool printSummary);
+
+    /// @brief Останавливает поток-сэмплер
+    ~MiningTelemetry();
+
+    MiningTelemetry(const MiningTelemetry &) = delete;
+    MiningTelemetry &operator=(const MiningTelemetry &) = delete;
+
+    /**
+     * @brief Учитывает хеши, посчитанные рабочим потоком
+     * @param workerIndex Индекс потока (только этот поток пишет свой счетчик)
+     * @param hashes Количество хешей
+     */
+    void recordHashes(unsigned int workerIndex, uint64_t hashes)
+    {
+        std::atomic<uint64_t> &counter = counters[workerIndex].hashes;
+        counter.store(counter.load(std::memory_order_relaxed) + hashes, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Учитывает найденное решение
+     * @param solveTimeMs Время от начала задания до решения, мс
+     */
+    void recordSolution(uint64_t solveTimeMs);
+
+    /// @brief Учитывает отмененное (устаревшее) задание
+    void recordStaleJob();
+
+    /// @brief Возвращает метрики последнего опроса
+    Snapshot snapshot() const;
+
+    /// @brief Форматирует итоговую строку метрик
+    static std::string formatSummary(const Snapshot &snapshot);
+
+private:
+    /// @brief Счетчик потока на отдельной кеш-линии (исключает false sharing)
+    struct alignas(64) WorkerCounter
+    {
+        std::atomic<uint64_t> hashes{0};
+    };
+
+    std::unique_ptr<WorkerCounter[]> counters;  ///< Счетчики рабочих потоков
+    unsigned int workerCount;                   ///< Количество рабочих потоков
+    std::chrono::milliseconds sampleInterval;   ///< Период опроса
+    bool printSummary;                          ///< Печатать итоговую строку
+
+    std::atomic<uint64_t> blocksSolved{0};      ///< Найдено решений
+    std::atomic<uint64_t> staleJobs{0};         ///< Устаревших заданий
+    std::atomic<uint64_t> totalSolveTimeMs{0};  ///< Суммарное время поиска решений
+    std::atomic<uint64_t> lastSolveTimeMs{0};   ///< Время поиска последнего решения
+
+    mutable std::mutex snapshotMutex;           ///< Защита последнего снимка и остановки
+    std::condition_variable stopCondition;      ///< Пробуждение сэмплера при остановке
+    Snapshot lastSnapshot;                      ///< Последний снимок
+    bool stopping = false;                      ///< Флаг остановки сэмплера
+    std::thread sampler;                        ///< Поток-сэмплер
+
+    /// @brief Цикл потока-сэмплера
+    void samplerLoop();
+};
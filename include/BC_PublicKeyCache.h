@@ -0,0 +1,81 @@
+// BC_PublicKeyCache.h
+#pragma once
+
+// Системные библиотеки
+#include <string>
+#include <string_view>
+#include <memory>
+#include <shared_mutex>
+
+#include "BC_CryptoUtils.h"
+#include "BC_FlatStringMap.h"
+
+// OpenSSL компоненты
+#include <openssl/evp.h>
+
+/**
+ * @brief Кеш разобранных публичных ключей пользователей.
+ *
+ * PEM каждого пользователя разбирается один раз при добавлении ключа; проверки
+ * подписей получают готовый EVP_PKEY. Замена ключа пользователя делает прежний
+ * дескриптор недействительным для новых запросов (уже выданные остаются живыми
+ * благодаря shared_ptr). Потокобезопасен: чтение под разделяемой блокировкой.
+ */
+class PublicKeyCache
+{
+public:
+    using KeyHandle = std::shared_ptr<EVP_PKEY>;    ///< Разобранный ключ с владением
+
+    /// @brief Разобранный ключ вместе с отпечатком
+    struct KeyEntry
+    {
+        KeyHandle key;                      ///< Ключ (nullptr - не зарегистрирован)
+        CryptoUtils::Digest fingerprint{};  ///< SHA-256 от DER-представления публичного ключа
+    };
+
+    PublicKeyCache() = default;
+
+    /**
+     * @brief Разбирает все ключи из карты PEM
+     * @param publicKeys Соответствие пользователей и PEM публичных ключей
+     */
+    explicit PublicKeyCache(const FlatStringMap<std::string> &publicKeys);
+
+    PublicKeyCache(const PublicKeyCache &) = delete;
+    PublicKeyCache &operator=(const PublicKeyCache &) = delete;
+
+    /**
+     * @brief Добавляет или заменяет ключ пользователя
+     * @param username Имя пользователя
+     * @param publicKeyPEM Публичный ключ в формате PEM
+     * @return false, если PEM не удалось разобрать (прежний ключ удаляется)
+     */
+    bool setKey(const std::string &username, const std::string &publicKeyPEM);
+
+    /**
+     * @brief Удаляет ключ пользователя из кеша
+     * @param username Имя пользователя
+     */
+    void invalidate(std::string_view username);
+
+    /**
+     * @brief Возвращает разобранный ключ пользователя
+     * @param username Имя пользователя
+     * @return Ключ или nullptr, если ключ не зарегистрирован
+     */
+    KeyHandle find(std::string_view username) const;
+
+    /**
+     * @brief Возвращает разобранный ключ пользователя вместе с отпечатком
+     * @param username Имя пользователя
+     * @return Запись с key == nullptr, если ключ не зарегистрирован
+     */
+    KeyEntry findEntry(std::string_view username) const;
+
+    /// @brief Количество ключей в кеше
+    size_t size() const;
+
+private:
+    mutable std::shared_mutex mutex;                        ///< Синхронизация доступа к ключам
+    FlatStringMap<KeyEntry> keys;                           ///< Разобранные ключи пользователей
+};
@@ -0,0 +1,125 @@
+// BC_Sha256Lanes.h
+#pragma once
+
+// Системные библиотеки
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Многопоточный (multi-buffer) SHA-256 для перебора nonce.
+ *
+ * Хеширует за один проход сразу несколько кандидатов nonce, раскладывая их
+ * по SIMD-линиям: 4 (SSE4.1), 8 (AVX2) или 16 (AVX-512). Реализация выбирается
+ * во время выполнения по возможностям процессора; при их отсутствии используется
+ * скалярный код.
+ *
+ * Перед первым использованием каждая реализация проходит known-answer проверку
+ * против OpenSSL SHA256() и скалярного кода. Реализация, не прошедшая проверку,
+ * отключается. Ту же проверку для всех собранных реализаций выполняет
+ * BlockchainBenchmarks --self-check.
+ */
+class Sha256Lanes
+{
+public:
+    static constexpr size_t DIGEST_SIZE = 32;   ///< Размер хеша SHA-256 в байтах
+    static constexpr size_t NONCE_SIZE = 8;     ///< Размер суффикса nonce в байтах
+    static constexpr size_t MAX_LANES = 16;     ///< Максимальная ширина пакета
+
+    /// @brief Доступные реализации
+    enum class Backend
+    {
+        Scalar,     ///< Переносимый скалярный код, 1 линия
+        SSE41,      ///< SSE4.1, 4 линии
+        AVX2,       ///< AVX2, 8 линий
+        AVX512      ///< AVX-512F, 16 линий
+    };
+
+    /// @brief Результат known-answer проверки реализации
+    enum class CheckResult
+    {
+        Passed,         ///< Все хеши совпали с эталоном
+        Failed,         ///< Хотя бы один хеш не совпал
+        NotBuilt,       ///< Реализация не собрана для этой платформы
+        Unsupported     ///< Процессор или ОС не поддерживают набор инструкций
+    };
+
+    /**
+     * @brief Состояние SHA-256 после обработки префикса сообщения
+     *
+     * Хранит промежуточное состояние после всех полных 64-байтовых блоков префикса
+     * и подготовленный хвост (остаток префикса, место под nonce, паддинг и длина).
+     */
+    struct Midstate
+    {
+        uint32_t state[8];          ///< Промежуточное состояние H0..H7
+        uint32_t tailWords[32];     ///< Хвостовые блоки (big-endian слова, байты nonce обнулены)
+        size_t tailBlocks;          ///< Количество хвостовых блоков (1 или 2)
+        size_t nonceOffset;         ///< Смещение nonce в хвосте (в байтах)
+    };
+
+    /**
+     * @brief Подготавливает midstate для сообщения вида prefix || nonce (8 байт, little-endian)
+     * @param prefix Часть сообщения, не зависящая от nonce
+     * @return Midstate, пригодный для всех реализаций
+     */
+    static Midstate prepare(const std::string &prefix);
+
+    /**
+     * @brief Хеширует laneCount() последовательных nonce активной реализацией
+     * @param midstate Подготовленное состояние
+     * @param firstNonce Nonce первой линии; линия i получает firstNonce + i
+     * @param out Буфер на laneCount() * DIGEST_SIZE байт
+     */
+    static void hashNonces(const Midstate &midstate, uint64_t firstNonce, unsigned char *out);
+
+    /**
+     * @brief Хеширует lanesOf(backend) последовательных nonce указанной реализацией
+     * @param backend Реализация, ранее полученная из activeBackend()
+     * @param midstate Подготовленное состояние
+     * @param firstNonce Nonce первой линии; линия i получает firstNonce + i
+     * @param out Буфер на lanesOf(backend) * DIGEST_SIZE байт
+     * @throw std::invalid_argument Если реализация не собрана для этой платформы
+     * @note Не зависит от последующих вызовов selectBackend()
+     */
+    static void hashNonces(Backend backend, const Midstate &midstate, uint64_t firstNonce, unsigned char *out);
+
+    /**
+     * @brief Хеширует один nonce скалярным кодом
+     * @param midstate Подготовленное состояние
+     * @param nonce Значение nonce
+     * @param out Буфер на DIGEST_SIZE байт
+     */
+    static void hashNonce(const Midstate &midstate, uint64_t nonce, unsigned char *out);
+
+    /// @brief Количество линий активной реализации
+    static size_t laneCount();
+
+    /// @brief Активная реализация
+    static Backend activeBackend();
+
+    /**
+     * @brief Принудительно выбирает реализацию (например, для бенчмарков)
+     * @param backend Желаемая реализация
+     * @return false, если процессор ее не поддерживает или она не прошла проверку
+     * @note Запущенные задания майнинга не затрагиваются: MiningEngine фиксирует
+     *       реализацию и число линий при создании
+     */
+    static bool selectBackend(Backend backend);
+
+    /// @brief Имя реализации для логов
+    static const char *backendName(Backend backend);
+
+    /// @brief Количество линий указанной реализации
+    static size_t lanesOf(Backend backend);
+
+    /**
+     * @brief Выполняет known-answer проверку реализации независимо от активной
+     * @param backend Проверяемая реализация
+     * @return Passed или Failed; NotBuilt и Unsupported, если реализацию нельзя выполнить
+     * @details Сравнивает с OpenSSL SHA256() и hashNonce() префиксы с одним и двумя
+     *          хвостовыми блоками, nonce с переносом через 32 бита и диапазоны nonce
+     *          нечетной длины короче и длиннее пакета (от последнего пакета нужна часть линий)
+     */
+    static CheckResult verifyBackend(Backend backend);
+};
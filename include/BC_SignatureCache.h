@@ -0,0 +1,97 @@
+// BC_SignatureCache.h
+#pragma once
+
+// Системные библиотеки
+#include <string>
+#include <string_view>
+#include <array>
+#include <deque>
+#include <unordered_map>
+#include <mutex>
+#include <cstddef>
+
+#include "BC_CryptoUtils.h"
+#include "BC_Hash256.h"
+
+/**
+ * @brief Ограниченный потокобезопасный кеш уже проверенных подписей.
+ *
+ * Запись - тройка (txId, дайджест подписи, отпечаток ключа). Дайджест подписи
+ * вычисляется по подписанным данным вместе с байтами подписи, поэтому любое
+ * изменение полей транзакции, подписи или ключа отправителя дает промах и
+ * полную криптографическую проверку. Кеш разбит на сегменты со своими мьютексами;
+ * при переполнении сегмента вытесняется самая старая запись (FIFO).
+ */
+class SignatureCache
+{
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 1 << 16;  ///< Емкость по умолчанию (записей)
+
+    /// @brief Проверенная подпись
+    struct Entry
+    {
+        CryptoUtils::Digest signatureDigest{};  ///< SHA-256 подписанных данных и подписи
+        CryptoUtils::Digest keyFingerprint{};   ///< Отпечаток публичного ключа отправителя
+    };
+
+    /**
+     * @brief Создает пустой кеш
+     * @param capacity Максимальное число записей (0 - кеш отключен)
+     */
+    explicit SignatureCache(size_t capacity = DEFAULT_CAPACITY);
+
+    SignatureCache(const SignatureCache &) = delete;
+    SignatureCache &operator=(const SignatureCache &) = delete;
+
+    /**
+     * @brief Вычисляет дайджест подписи
+     * @param signedData Подписанные данные транзакции
+     * @param signature Подпись в бинарном виде
+     * @return SHA-256 от signedData и байтов подписи
+     */
+    static CryptoUtils::Digest signatureDigest(std::string_view signedData,
+                                               CryptoUtils::SignatureView signature);
+
+    /**
+     * @brief Запоминает успешно проверенную подпись
+     * @param txId Идентификатор транзакции
+     * @param entry Дайджест подписи и отпечаток ключа
+     */
+    void insert(const Hash256 &txId, const Entry &entry);
+
+    /**
+     * @brief Проверяет, была ли подпись уже проверена
+     * @param txId Идентификатор транзакции
+     * @param entry Дайджест подписи и отпечаток ключа
+     * @return true только при совпадении всех трех компонентов
+     */
+    bool contains(const Hash256 &txId, const Entry &entry) const;
+
+    /// @brief Удаляет все записи
+    void clear();
+
+    /// @brief Текущее количество записей
+    size_t size() const;
+
+    /// @brief Максимальное количество записей
+    size_t getCapacity() const;
+
+private:
+    static constexpr size_t SHARD_COUNT = 16;           ///< Количество сегментов
+
+    /// @brief Сегмент кеша со своей блокировкой
+    struct Shard
+    {
+        mutable std::mutex mutex;                       ///< Синхронизация сегмента
+        std::unordered_map<Hash256, Entry> entries;     ///< Записи по txId
+        std::deque<Hash256> order;                      ///< Порядок вставки для вытеснения
+    };
+
+    size_t capacity;                                    ///< Общая емкость
+    size_t shardCapacity;                               ///< Емкость одного сегмента
+    std::array<Shard, SHARD_COUNT> shards;              ///< Сегменты
+
+    /// @brief Сегмент, отвечающий за txId
+    Shard &shardFor(const Hash256 &txId);
+    const Shard &shardFor(const Hash256 &txId) const;
+};
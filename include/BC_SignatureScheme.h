@@ -0,0 +1,91 @@
+// BC_SignatureScheme.h
+#pragma once
+
+// Системные библиотеки
+#include <string>
+
+// Пользовательские заголовки
+#include "BC_CryptoUtils.h"
+
+// OpenSSL компоненты
+#include <openssl/evp.h>
+
+/**
+ * @brief Схема цифровой подписи поверх OpenSSL EVP.
+ *
+ * Каждая схема определяет генерацию ключей, хеш-функцию и параметры подписи.
+ * Схема выбирается по типу ключа (forKey), поэтому в одной цепочке могут
+ * сосуществовать пользователи с ключами разных схем.
+ *
+ * | Схема       | Подпись        | Ключ           |
+ * |-------------|----------------|----------------|
+ * | RSA-2048    | 256 байт       | PKCS#1 v1.5    |
+ * | Ed25519     | 64 байта       | PureEdDSA      |
+ * | ECDSA P-256 | ~72 байта (DER)| SHA-256        |
+ */
+class SignatureScheme
+{
+public:
+    /// @brief Поддерживаемые алгоритмы
+    enum class Algorithm
+    {
+        RSA2048,
+        Ed25519,
+        EcdsaP256
+    };
+
+    virtual ~SignatureScheme() = default;
+
+    /// @brief Алгоритм схемы
+    virtual Algorithm algorithm() const = 0;
+
+    /// @brief Короткое имя схемы ("rsa2048", "ed25519", "p256")
+    virtual const char *name() const = 0;
+
+    /**
+     * @brief Генерирует новую пару ключей схемы
+     * @return Ключ (освобождается EVP_PKEY_free) или nullptr при ошибке
+     */
+    virtual EVP_PKEY *generateKeyPair() const = 0;
+
+    /**
+     * @brief Подписывает данные
+     * @param privateKey Приватный ключ этой схемы
+     * @param data Данные для подписи
+     * @return Бинарная подпись (пустая при ошибке, ошибки логируются в ConsoleUI)
+     */
+    CryptoUtils::Signature sign(EVP_PKEY *privateKey, std::string_view data) const;
+
+    /**
+     * @brief Проверяет подпись
+     * @param publicKey Публичный ключ этой схемы
+     * @param data Исходные данные
+     * @param signature Бинарная подпись
+     * @return true - подпись верна
+     */
+    bool verify(EVP_PKEY *publicKey, std::string_view data, CryptoUtils::SignatureView signature) const;
+
+    /// @brief Схема по алгоритму
+    static const SignatureScheme &get(Algorithm algorithm);
+
+    /**
+     * @brief Определяет схему по типу и параметрам ключа
+     * @return Схема или nullptr для неподдерживаемого типа ключа, RSA не 2048 бит
+     *         или EC-ключа не на кривой prime256v1
+     */
+    static const SignatureScheme *forKey(EVP_PKEY *key);
+
+    /**
+     * @brief Ищет схему по имени
+     * @param name Имя схемы ("rsa2048"/"rsa", "ed25519", "p256"/"ecdsa")
+     * @return Схема или nullptr, если имя неизвестно
+     */
+    static const SignatureScheme *fromName(const std::string &name);
+
+protected:
+    /// @brief Хеш-функция подписи (nullptr - схема хеширует данные сама, как Ed25519)
+    virtual const EVP_MD *digest() const = 0;
+
+    /// @brief Дополнительная настройка контекста ключа (например, паддинг RSA)
+    virtual bool configure(EVP_PKEY_CTX *keyContext) const;
+};
@@ -0,0 +1,75 @@
+// BC_Target.h
+#pragma once
+
+// Системные библиотеки
+#include <array>
+#include <string>
+#include <cstdint>
+#include <compare>
+
+/**
+ * @brief 256-битная цель Proof-of-Work.
+ *
+ * Хранится как 32 байта big-endian, поэтому сравнение с хешем SHA-256 - это
+ * лексикографическое сравнение байтов без HEX-кодирования. Блок хранит цель в
+ * компактном виде (32 бита: 1 байт порядка и 23 бита мантиссы, как nBits в Bitcoin),
+ * что позволяет менять сложность с точностью лучше одного бита.
+ */
+class Target256
+{
+public:
+    static constexpr size_t SIZE = 32;                      ///< Размер цели в байтах
+    static constexpr uint32_t POW_LIMIT_BITS = 0x2000ffff;  ///< Минимальная сложность (8 ведущих нулевых бит)
+    static constexpr uint32_t GENESIS_BITS = 0x1f00ffff;    ///< Стартовая сложность (16 ведущих нулевых бит)
+
+    /// @brief Создает нулевую цель (недостижимую)
+    Target256();
+
+    /**
+     * @brief Декодирует компактное представление
+     * @param bits Компактная цель
+     * @return Цель; для отрицательной мантиссы или переполнения возвращается нулевая цель
+     */
+    static Target256 fromCompact(uint32_t bits);
+
+    /// @brief Минимально допустимая сложность (максимальная цель)
+    static Target256 powLimit();
+
+    /// @brief Кодирует цель в компактное представление (с округлением вниз)
+    uint32_t toCompact() const;
+
+    /**
+     * @brief Проверяет, удовлетворяет ли хеш цели
+     * @param digest 32 байта хеша SHA-256
+     * @return true, если хеш как big-endian число не превышает цель
+     */
+    bool isMetBy(const unsigned char *digest) const;
+
+    /**
+     * @brief Масштабирует цель на дробь numerator / denominator
+     * @return Новая цель; при переполнении - максимально возможное значение
+     * @throw std::invalid_argument Если denominator == 0
+     */
+    Target256 scaled(uint32_t numerator, uint32_t denominator) const;
+
+    /// @brief Количество ведущих нулевых бит (для логов)
+    int leadingZeroBits() const;
+
+    /// @brief HEX-представление цели (64 символа)
+    std::string toHex() const;
+
+    /**
+     * @brief Пересчитывает сложность по измеренному времени поиска блока
+     * @param bits Текущая компактная цель
+     * @param actualMs Фактическое среднее время поиска блока в миллисекундах
+     * @param expectedMs Целевое время поиска блока в миллисекундах
+     * @return Новая компактная цель; изменение ограничено 4 раза за шаг и POW_LIMIT_BITS
+     */
+    static uint32_t retarget(uint32_t bits, uint32_t actualMs, uint32_t expectedMs);
+
+    auto operator<=>(const Target256 &) const = default;
+    bool operator==(const Target256 &) const = default;
+
+private:
+    std::array<unsigned char, SIZE> value;  ///< Значение цели (big-endian)
+};
@@ -3,6 +3,15 @@
 
 // Системные библиотеки
 #include <string>
+#include <vector>
+#include <string_view>
+#include <cstdint>
+#include <concepts>
+
+#include "BC_Hash256.h"
+#include "BC_Amount.h"
+#include "BC_AccountRegistry.h"
+#include "BC_Utilities.h"
 
 /**
  * @class Transaction
@@ -14,34 +23,46 @@
  */
 class Transaction
 {
+public:
+    static constexpr uint8_t ENCODING_VERSION = 2;  ///< Версия канонического кодирования
+
 private:
     std::string sender;     ///< Блокчейн-адрес отправителя (валидируется при создании)
     std::string receiver;   ///< Блокчейн-адрес получателя (валидируется при создании)
-    double amount;          ///< Сумма перевода (>0, иначе инициализируется 0)
-    std::string txId;       ///< Уникальный SHA256-хеш (sender+receiver+amount+timestamp+metadata)
-    std::string timestamp;  ///< Временная метка в ISO 8601 от TimeUtils
+    Amount amount;          ///< Сумма перевода в минимальных единицах (>0, иначе инициализируется 0)
+    Hash256 txId;           ///< Уникальный SHA256-хеш (sender+receiver+amount+timestamp+metadata)
+    Timestamp timestamp;    ///< Время создания в наносекундах от эпохи (TimeUtils::now)
     std::string metadata;   ///< Произвольные данные (обрезаются до 512 символов при инициализации)
-    std::string signature;  ///< ECDSA-подпись в формате PEM (генерируется signTransaction)
+    std::vector<unsigned char> signature;   ///< Бинарная подпись, схема задается ключом отправителя (генерируется signTransaction)
+    AccountId senderId = AccountRegistry::NO_ACCOUNT;   ///< Плотный id отправителя (назначается при допуске в блок)
+    AccountId receiverId = AccountRegistry::NO_ACCOUNT; ///< Плотный id получателя (назначается при допуске в блок)
+    std::string encoded;    ///< Каноническое бинарное представление (см. getEncoded)
+    size_t signedLength;    ///< Длина подписываемого префикса encoded
 
     /**
-     * @brief Генерирует детерминированные данные для подписи
-     * @return Конкатенация полей в порядке: txId + sender + receiver + 
-     *         std::to_string(amount) + timestamp + metadata
-     * @warning Изменение формата приведет к ошибкам верификации существующих подписей
+     * @brief Кодирует поля транзакции (без txId и подписи)
+     * @param out Буфер, в который дописываются поля
      */
-    std::string getDataToSign() const;
+    void encodeFields(std::string &out) const;
+
+    /// @brief Заменяет подпись в конце канонического представления
+    void encodeSignature();
 
 public:
     /**
      * @brief Создает транзакцию с базовой валидацией полей
      * @param from Адрес отправителя (только валидные Base58Check-адреса)
      * @param to Адрес получателя (аналогично from)
-     * @param value Положительная сумма перевода (<=0 инициализирует 0)
+     * @param value Положительная сумма перевода в минимальных единицах (<=0 инициализирует 0)
      * @param meta Метаданные (обрезаются до 512 символов, могут быть пустыми)
      * @throws implicit: неявная инициализация невалидных полей пустыми значениями/нулем
      * @note Автоматически генерирует txId и timestamp через CryptoUtils и TimeUtils
      */
-    Transaction(const std::string &from, const std::string &to, double value, const std::string &meta = "");
+    Transaction(const std::string &from, const std::string &to, Amount value, const std::string &meta = "");
+
+    /// @brief Дробные суммы разбираются AmountUtils::parse, неявное усечение запрещено
+    template <std::floating_point T>
+    Transaction(const std::string &from, const std::string &to, T value, const std::string &meta = "") = delete;
 
     /**
      * @brief Выполняет криптографическое подписание транзакции
@@ -61,13 +82,40 @@ public:
      */
     std::string toString() const;
 
+    /**
+     * @brief Данные, покрываемые подписью
+     * @return txId (32 байта) + кодированные поля; ссылается на внутренний буфер
+     */
+    std::string_view getSigningData() const;
+
+    /**
+     * @brief Каноническое бинарное представление транзакции
+     * @return Подписываемые данные + подпись с префиксом длины
+     * @details Поля кодируются один раз при создании транзакции, подпись - при подписании:
+     * version(u8) | sender | receiver | amount(i64) | timestamp(i64, нс) | metadata,
+     * строки - с префиксом длины u32, числа - little-endian. txId = SHA-256 от этих полей.
+     * Используется для txId, подписи, проверки, хеширования блока и сохранения цепочки.
+     */
+    const std::string &getEncoded() const;
+
+    /**
+     * @brief Привязывает транзакцию к счетам реестра
+     * @param sender Идентификатор отправителя (NO_ACCOUNT для системных транзакций)
+     * @param receiver Идентификатор получателя
+     * @note Идентификаторы локальны для узла и не входят в каноническое представление
+     */
+    void bindAccounts(AccountId sender, AccountId receiver);
+
     /// @{ Группа методов только для чтения (поля защищены от прямой модификации)
-    const std::string &getTxId() const;         ///< Хеш-идентификатор транзакции
+    const Hash256 &getTxId() const;             ///< Хеш-идентификатор транзакции
     const std::string &getSender() const;       ///< Нормализованный адрес отправителя
-    const std::string &getSignature() const;    ///< Подпись в PEM или пустая строка
+    const std::vector<unsigned char> &getSignature() const; ///< Бинарная подпись или пустой буфер
+    std::string getSignatureHex() const;        ///< Подпись в HEX (для вывода и экспорта)
     const std::string &getReceiver() const;     ///< Нормализованный адрес получателя
-    const std::string &getTimestamp() const;    ///< Временная метка создания транзакции
+    Timestamp getTimestamp() const;             ///< Время создания в наносекундах от эпохи
     const std::string &getMetadata() const;     ///< Метаданные (обрезанная версия)
-    const double &getAmount() const;            ///< Фактически сохраненная сумма
+    AccountId getSenderId() const;              ///< Плотный id отправителя
+    AccountId getReceiverId() const;            ///< Плотный id получателя
+    const Amount &getAmount() const;            ///< Фактически сохраненная сумма (минимальные единицы)
     /// @}
 };
\ No newline at end of file
@@ -4,6 +4,10 @@
 // Системные библиотеки
 #include <string>
 #include <vector>
+#include <cstdint>
+
+/// Время в наносекундах от эпохи Unix (UTC)
+using Timestamp = int64_t;
 
 /**
  * @brief Класс для работы с консольным интерфейсом системы
@@ -97,16 +101,28 @@ public:
 
 /**
  * @brief Класс утилит для работы со временем
+ *
+ * Метки времени хранятся как 64-битные наносекунды от эпохи. Строка ISO 8601
+ * формируется только при отображении.
  */
 class TimeUtils
 {
 public:
     /**
-     * @brief Возвращает текущее время в формате строки
-     * @return Строка времени в формате "ГГГГ-ММ-ДД ЧЧ:ММ:СС"
-     * @note Реализация учитывает платформозависимые функции работы со временем
+     * @brief Возвращает текущее время в наносекундах от эпохи
+     * @return Метка, строго большая любой ранее выданной в процессе
+     * @note Системное время считывается один раз при первом вызове, далее к нему
+     *       прибавляется показание монотонных часов: метки не зависят от перевода
+     *       системных часов и не повторяются даже при создании транзакций подряд
+     */
+    static Timestamp now();
+
+    /**
+     * @brief Форматирует метку времени в строку ISO 8601 (UTC)
+     * @param timestamp Наносекунды от эпохи
+     * @return Строка вида "ГГГГ-ММ-ДДTЧЧ:ММ:СС.нннннннннZ"
      */
-    static std::string getCurrentTime();
+    static std::string toIso8601(Timestamp timestamp);
 };
 
 
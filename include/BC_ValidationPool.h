@@ -0,0 +1,84 @@
+// BC_ValidationPool.h
+#pragma once
+
+// Системные библиотеки
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <exception>
+#include <cstdint>
+
+/**
+ * @brief Пул потоков для параллельной проверки транзакций без состояния.
+ *
+ * Потоки создаются один раз и паркуются между пакетами. Вызывающий поток
+ * участвует в обработке пакета наравне с рабочими, поэтому пул без рабочих
+ * потоков выполняет пакет последовательно. Индексы раздаются атомарным счетчиком,
+ * так что неравномерная стоимость элементов (разные ключи, длины) балансируется сама.
+ *
+ * Пакеты разных потоков обслуживаются по очереди поступления, а длинный пакет
+ * выполняется порциями по CHUNK_SIZE элементов: полная проверка цепочки не
+ * задерживает проверку пакета пула транзакций дольше, чем на одну порцию.
+ */
+class ValidationPool
+{
+public:
+    /// @brief Максимум элементов, обрабатываемых без уступки пула пакетам других потоков
+    static constexpr size_t CHUNK_SIZE = 4096;
+
+    /**
+     * @brief Создает пул и запускает рабочие потоки
+     * @param workerCount Число рабочих потоков (0 - только вызывающий поток)
+     * @param pinThreads Закрепить поток i за ядром i (ядра, зарезервированные под валидацию)
+     */
+    explicit ValidationPool(unsigned int workerCount, bool pinThreads = false);
+
+    /// @brief Останавливает и присоединяет рабочие потоки
+    ~ValidationPool();
+
+    ValidationPool(const ValidationPool &) = delete;
+    ValidationPool &operator=(const ValidationPool &) = delete;
+
+    /**
+     * @brief Выполняет body(i) для всех i из [0, count) и ждет завершения
+     * @param count Количество элементов
+     * @param body Обработчик элемента; вызывается конкурентно и не должен разделять изменяемое состояние
+     * @throw Повторно выбрасывает первое исключение, возникшее в обработчике
+     */
+    void parallelFor(size_t count, const std::function<void(size_t)> &body);
+
+    /// @brief Количество рабочих потоков (без вызывающего)
+    unsigned int getWorkerCount() const;
+
+private:
+    std::vector<std::thread> workers;               ///< Рабочие потоки
+
+    std::mutex stateMutex;                          ///< Защита состояния пакета ниже
+    std::condition_variable batchReady;             ///< Сигнал рабочим о новом пакете
+    std::condition_variable batchDone;              ///< Сигнал вызывающему о завершении рабочих
+    std::condition_variable turnReady;              ///< Сигнал очередной порции о свободном пуле
+    uint64_t nextTicket = 0;                        ///< Номер следующей порции в очереди
+    uint64_t servingTicket = 0;                     ///< Номер порции, занимающей пул
+    const std::function<void(size_t)> *body = nullptr; ///< Обработчик текущего пакета
+    size_t count = 0;                               ///< Конец текущей порции (индекс за последним)
+    std::atomic<size_t> nextIndex{0};               ///< Следующий необработанный индекс
+    std::exception_ptr failure;                     ///< Первое исключение пакета
+    uint64_t generation = 0;                        ///< Номер текущего пакета
+    unsigned int busyWorkers = 0;                   ///< Рабочие, еще обрабатывающие пакет
+    bool stopping = false;                          ///< Флаг остановки пула
+
+    /// @brief Цикл рабочего потока
+    void workerLoop();
+
+    /// @brief Обрабатывает индексы текущего пакета, пока они не закончатся
+    void drain();
+
+    /**
+     * @brief Дожидается очереди и выполняет порцию [first, last) пакета на всех потоках
+     * @throw Повторно выбрасывает первое исключение порции
+     */
+    void runChunk(size_t first, size_t last, const std::function<void(size_t)> &itemBody);
+};
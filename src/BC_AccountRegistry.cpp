@@ -0,0 +1,38 @@
+// BC_AccountRegistry.cpp
+#include "BC_AccountRegistry.h"
+
+// Системные библиотеки (только для реализации)
+#include <mutex>
+
+std::pair<AccountId, bool> AccountRegistry::intern(std::string_view address)
+{
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    auto [id, inserted] = ids.tryEmplace(address);
+    if (inserted)
+    {
+        *id = static_cast<AccountId>(names.size());
+        names.emplace_back(address);
+    }
+    return {*id, inserted};
+}
+
+AccountId AccountRegistry::find(std::string_view address) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    const AccountId *id = ids.find(address);
+    return id ? *id : NO_ACCOUNT;
+}
+
+const std::string &AccountRegistry::nameOf(AccountId id) const
+{
+    static const std::string unknown;
+
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return id < names.size() ? names[id] : unknown;
+}
+
+size_t AccountRegistry::size() const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return names.size();
+}
@@ -0,0 +1,88 @@
+// BC_Amount.cpp
+#include "BC_Amount.h"
+
+// Системные библиотеки (только для реализации)
+#include <limits>
+
+bool AmountUtils::parse(std::string_view text, Amount &out)
+{
+    const Amount maxValue = std::numeric_limits<Amount>::max();
+    Amount whole = 0;
+    Amount fraction = 0;
+    int fractionDigits = 0;
+    bool seenPoint = false;
+    bool seenDigit = false;
+
+    for (char c : text)
+    {
+        if (c == '.' && !seenPoint)
+        {
+            seenPoint = true;
+            continue;
+        }
+        if (c < '0' || c > '9')
+            return false;
+
+        const int digit = c - '0';
+        seenDigit = true;
+        if (seenPoint)
+        {
+            if (++fractionDigits > DECIMALS)
+                return false;
+            fraction = fraction * 10 + digit;
+        }
+        else
+        {
+            if (whole > (maxValue - digit) / 10)
+                return false;
+            whole = whole * 10 + digit;
+        }
+    }
+
+    if (!seenDigit)
+        return false;
+
+    for (int i = fractionDigits; i < DECIMALS; ++i)
+    {
+        fraction *= 10;
+    }
+
+    if (whole > (maxValue - fraction) / UNITS_PER_COIN)
+        return false;
+
+    out = whole * UNITS_PER_COIN + fraction;
+    return true;
+}
+
+std::string AmountUtils::format(Amount value)
+{
+    // Модуль берется в беззнаковом типе, чтобы не переполниться на минимальном значении
+    const bool negative = value < 0;
+    const uint64_t magnitude = negative ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+    const uint64_t units = static_cast<uint64_t>(UNITS_PER_COIN);
+
+    std::string fraction = std::to_string(magnitude % units);
+    fraction.insert(0, DECIMALS - fraction.size(), '0');
+
+    return (negative ? "-" : "") + std::to_string(magnitude / units) + "." + fraction;
+}
+
+bool AmountUtils::add(Amount a, Amount b, Amount &result)
+{
+    if ((b > 0 && a > std::numeric_limits<Amount>::max() - b) ||
+        (b < 0 && a < std::numeric_limits<Amount>::min() - b))
+        return false;
+
+    result = a + b;
+    return true;
+}
+
+bool AmountUtils::subtract(Amount a, Amount b, Amount &result)
+{
+    if ((b < 0 && a > std::numeric_limits<Amount>::max() + b) ||
+        (b > 0 && a < std::numeric_limits<Amount>::min() + b))
+        return false;
+
+    result = a - b;
+    return true;
+}
@@ -3,97 +3,193 @@
 #include "BC_Transaction.h"
 #include "BC_CryptoUtils.h"
 #include "BC_Utilities.h"
+#include "BC_MiningEngine.h"
+#include "BC_MiningScheduler.h"
+#include "BC_Target.h"
+#include "BC_Encoding.h"
 
 // Системные библиотеки (только для реализации)
-#include <thread>
 #include <atomic>
 #include <sstream>
+#include <memory>
+#include <limits>
+#include <algorithm>
+#include <chrono>
+
+namespace
+{
+    // Состояние одного поиска решения, общее для всех рабочих потоков
+    struct MiningContext
+    {
+        Target256 target;                                   ///< Цель Proof-of-Work
+        MiningEngine baseEngine;                            ///< Midstate для extra-nonce = 0
+        uint64_t rangeSize;                                 ///< Размер диапазона nonce на поток
+        std::atomic<bool> found{false};                     ///< Решение найдено
+        std::chrono::steady_clock::time_point startTime;    ///< Начало поиска
+
+        MiningContext(uint32_t bits, const std::string &headerPrefix, unsigned int workers)
+            : target(Target256::fromCompact(bits)),
+              baseEngine(headerPrefix),
+              rangeSize(std::numeric_limits<uint64_t>::max() / workers),
+              startTime(std::chrono::steady_clock::now()) {}
+    };
+}
 
 // Реализация методов Block
-Block::Block(int idx, const std::string &prevHash, const std::vector<Transaction> &txs,
-             const std::map<std::string, double> &snapshot, int diff)
+Block::Block(int idx, const Hash256 &prevHash, BlockTransactions txs,
+             BalanceDelta delta, std::optional<BalanceSnapshot> checkpointSnapshot, NewAccounts accounts, uint32_t bits,
+             uint64_t parentSolveMs)
     : index(idx),
-      timestamp(TimeUtils::getCurrentTime()),
-      transactions(txs),
+      timestamp(TimeUtils::now()),
+      transactions(std::move(txs)),
       previousHash(prevHash),
       nonce(0),
-      balanceSnapshot(snapshot),
-      difficulty(diff)
+      extraNonce(0),
+      balanceDelta(std::move(delta)),
+      checkpoint(std::move(checkpointSnapshot)),
+      newAccounts(std::move(accounts)),
+      targetBits(bits),
+      parentSolveTimeMs(parentSolveMs),
+      solveTimeMs(0),
+      mined(false)
 {
     hash = calculateBlockHash(); // Пересчёт хеша после инициализации всех полей
-    mineBlock(difficulty);
 }
 
-void Block::mineBlock(int mine_difficulty)
+MiningJob Block::startMining(MiningScheduler &scheduler, MiningScheduler::Completion onComplete)
 {
-    std::string target(mine_difficulty, '0');
-    std::atomic<bool> found(false);
-    std::atomic<int> atomicNonce(0);
-    const unsigned int numThreads = std::thread::hardware_concurrency();
-    int printInterval = 60000;
+    const unsigned int numThreads = scheduler.getWorkerCount();
+
+    // Префикс заголовка сериализуется и хешируется один раз на весь поиск;
+    // каждый поток владеет непересекающимся диапазоном nonce, общий счетчик не нужен
+    auto context = std::make_shared<MiningContext>(targetBits, serializeHeaderPrefix(0), numThreads);
+    const uint64_t batch = context->baseEngine.batchSize();
 
-    ConsoleUI::printMining("Starting Proof-of-Work mining with " + std::to_string(numThreads) + " threads...");
+    ConsoleUI::printMining("Starting Proof-of-Work mining with " + std::to_string(numThreads) + " threads (" +
+                           Sha256Lanes::backendName(context->baseEngine.getBackend()) + ", " +
+                           std::to_string(batch) + " nonces per pass, target " + std::to_string(context->target.leadingZeroBits()) +
+                           " zero bits)...");
 
-    auto mining_task = [&]()
+    MiningTelemetry &telemetry = scheduler.getTelemetry();
+
+    auto mining_task = [this, context, batch, &telemetry](unsigned int threadIndex, unsigned int numWorkers,
+                                                          const std::atomic<bool> &cancelled)
     {
-        while (!found.load(std::memory_order_acquire))
-        {
-            const int currentNonce = atomicNonce.fetch_add(1, std::memory_order_relaxed);
-            const std::string currentHash = calculateBlockHashWithNonce(currentNonce);
+        unsigned char digests[Sha256Lanes::MAX_LANES * Sha256Lanes::DIGEST_SIZE];
+        std::unique_ptr<MiningEngine> rolledEngine;
+        const MiningEngine *engine = &context->baseEngine;
+
+        uint64_t threadExtraNonce = 0;
+        uint64_t rangeBegin = threadIndex * context->rangeSize;
+        uint64_t rangeLength = context->rangeSize;
+        uint64_t offset = 0;
 
-            if (currentNonce % printInterval == 0)
+        while (!context->found.load(std::memory_order_acquire) && !cancelled.load(std::memory_order_acquire))
+        {
+            // Диапазон исчерпан: поток переходит на собственный extra-nonce и весь диапазон nonce
+            if (rangeLength - offset < batch)
             {
-                ConsoleUI::printMining("Thread " + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) +
-                                       " - nonce: " + std::to_string(currentNonce) +
-                                       ", hash: " + currentHash);
+                threadExtraNonce = (threadExtraNonce == 0) ? threadIndex + 1 : threadExtraNonce + numWorkers;
+                // Тот же backend, что у базового движка: ширина пакета постоянна на все задание
+                rolledEngine = std::make_unique<MiningEngine>(serializeHeaderPrefix(threadExtraNonce),
+                                                              context->baseEngine.getBackend());
+                engine = rolledEngine.get();
+                rangeBegin = 0;
+                rangeLength = std::numeric_limits<uint64_t>::max();
+                offset = 0;
+                ConsoleUI::printMining("Nonce range exhausted, rolling extra-nonce to " + std::to_string(threadExtraNonce));
             }
 
-            if (currentHash.substr(0, mine_difficulty) == target)
+            const uint64_t firstNonce = rangeBegin + offset;
+            engine->hashBatch(firstNonce, digests);
+            offset += batch;
+
+            // Только relaxed-запись в собственную кеш-линию потока; вывод делает сэмплер
+            telemetry.recordHashes(threadIndex, batch);
+
+            for (uint64_t lane = 0; lane < batch; ++lane)
             {
-                nonce = currentNonce;
-                hash = currentHash;
-                found.store(true, std::memory_order_release);
-                ConsoleUI::printMining("Block mined: " + hash +
-                                       " (nonce: " + std::to_string(nonce) +
-                                       ") by thread " + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())));
+                const unsigned char *digest = digests + lane * Sha256Lanes::DIGEST_SIZE;
+                if (!context->target.isMetBy(digest))
+                    continue;
+
+                // Решение фиксирует только первый нашедший поток
+                if (!context->found.exchange(true, std::memory_order_acq_rel))
+                {
+                    nonce = firstNonce + lane;
+                    extraNonce = threadExtraNonce;
+                    hash = Hash256::fromBytes(digest);
+                    solveTimeMs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                                            std::chrono::steady_clock::now() - context->startTime)
+                                                            .count());
+                    mined = true;
+                    telemetry.recordSolution(solveTimeMs);
+                    ConsoleUI::printMining("Block mined: " + hash.toHex() +
+                                           " (nonce: " + std::to_string(nonce) +
+                                           ", extra-nonce: " + std::to_string(extraNonce) +
+                                           ") by thread " + std::to_string(threadIndex));
+                }
                 break;
             }
         }
     };
 
-    // Запуск пула потоков майнинга
-    std::vector<std::thread> threads;
-    for (unsigned int i = 0; i < numThreads; i++)
-    {
-        threads.emplace_back(mining_task);
-    }
-    for (auto &th : threads)
+    // Блок передается долгоживущему пулу как задание
+    return scheduler.submit(mining_task, std::move(onComplete));
+}
+
+void Block::mineBlock(MiningScheduler &scheduler)
+{
+    const MiningJob job = startMining(scheduler);
+    job.wait();
+    if (const std::exception_ptr error = job.getError())
     {
-        th.join();
+        std::rethrow_exception(error);
     }
 }
 
-std::string Block::calculateBlockHashWithNonce(int testNonce) const
+std::string Block::serializeHeaderPrefix(uint64_t extra) const
 {
-    std::stringstream hashStream;
+    const size_t transactionBytes = transactions.size() * sizeof(uint32_t) + transactions.arenaSize();
+
+    std::string header;
+    header.reserve(80 + transactionBytes + MiningEngine::NONCE_SIZE);
 
-    hashStream << index
-               << timestamp
-               << previousHash
-               << testNonce;
+    Encoding::appendU64(header, static_cast<uint64_t>(index));
+    Encoding::appendU64(header, static_cast<uint64_t>(timestamp));
+    previousHash.appendTo(header);
+    Encoding::appendU32(header, targetBits);
+    Encoding::appendU64(header, parentSolveTimeMs);
+    Encoding::appendU64(header, extra);
 
-    // Включение хешей всех транзакций
+    // Транзакции в каноническом бинарном представлении (лежат подряд в арене блока)
+    Encoding::appendU32(header, static_cast<uint32_t>(transactions.size()));
     for (const auto &tx : transactions)
     {
-        hashStream << tx.toString();
+        Encoding::appendString(header, tx.getEncoded());
     }
 
-    return CryptoUtils::calculateHash(hashStream.str());
+    return header;
+}
+
+Hash256 Block::calculateBlockHashWithNonce(uint64_t testNonce) const
+{
+    // Nonce располагается в конце заголовка, чтобы префикс можно было кешировать при майнинге
+    std::string header = serializeHeaderPrefix(extraNonce);
+    MiningEngine::appendNonce(header, testNonce);
+    return Hash256(CryptoUtils::calculateDigest(header));
+}
+
+Hash256 Block::calculateBlockHash() const
+{
+    return Hash256(CryptoUtils::calculateDigest(serializeHeader()));
 }
 
-std::string Block::calculateBlockHash() const
+std::string Block::serializeHeader() const
 {
-    return calculateBlockHashWithNonce(nonce);
+    std::string header = serializeHeaderPrefix(extraNonce);
+    MiningEngine::appendNonce(header, nonce);
+    return header;
 }
 
 void Block::printBlock() const
@@ -103,7 +199,7 @@ void Block::printBlock() const
        << "|           BEGIN BLOCK INFO       |\n"
        << "+----------------------------------+\n"
        << "| Index:        " << index << "\n"
-       << "| Timestamp:    " << timestamp << "\n"
+       << "| Timestamp:    " << TimeUtils::toIso8601(timestamp) << "\n"
        << "+----------------------------------+\n"
        << "| Transactions: \n";
 
@@ -123,10 +219,16 @@ void Block::printBlock() const
 }
 
 // Геттеры
-const std::string &Block::getTimestamp() const { return timestamp; }
-const std::string &Block::getHash() const { return hash; }
-const std::string &Block::getPreviousHash() const { return previousHash; }
-const std::vector<Transaction> &Block::getTransactions() const { return transactions; }
+Timestamp Block::getTimestamp() const { return timestamp; }
+const Hash256 &Block::getHash() const { return hash; }
+const Hash256 &Block::getPreviousHash() const { return previousHash; }
+const BlockTransactions &Block::getTransactions() const { return transactions; }
 const int &Block::getIndex() const { return index; }
-const int &Block::getDifficulty() const { return difficulty; }
-const std::map<std::string, double> &Block::getBalanceSnapshot() const { return balanceSnapshot; }
\ No newline at end of file
+const uint32_t &Block::getTargetBits() const { return targetBits; }
+const uint64_t &Block::getSolveTimeMs() const { return solveTimeMs; }
+const uint64_t &Block::getParentSolveTimeMs() const { return parentSolveTimeMs; }
+bool Block::isMined() const { return mined; }
+const Block::BalanceDelta &Block::getBalanceDelta() const { return balanceDelta; }
+bool Block::hasCheckpoint() const { return checkpoint.has_value(); }
+const Block::BalanceSnapshot &Block::getCheckpoint() const { return *checkpoint; }
+const Block::NewAccounts &Block::getNewAccounts() const { return newAccounts; }
\ No newline at end of file
@@ -0,0 +1,103 @@
+// BC_BlockTransactions.cpp
+#include "BC_BlockTransactions.h"
+#include "BC_Transaction.h"
+#include "BC_Encoding.h"
+
+// Системные библиотеки (только для реализации)
+#include <sstream>
+
+BlockTransactions::BlockTransactions(const std::vector<Transaction> &transactions)
+{
+    size_t arenaBytes = 0;
+    for (const auto &tx : transactions)
+    {
+        arenaBytes += tx.getEncoded().size();
+    }
+
+    amounts.reserve(transactions.size());
+    senderIds.reserve(transactions.size());
+    receiverIds.reserve(transactions.size());
+    txIds.reserve(transactions.size());
+    timestamps.reserve(transactions.size());
+    rows.reserve(transactions.size());
+    arena.reserve(arenaBytes);
+
+    for (const auto &tx : transactions)
+    {
+        append(tx);
+    }
+}
+
+void BlockTransactions::append(const Transaction &tx)
+{
+    Row row;
+    row.begin = static_cast<uint32_t>(arena.size());
+    arena += tx.getEncoded();
+    row.end = static_cast<uint32_t>(arena.size());
+    row.signedEnd = row.begin + static_cast<uint32_t>(tx.getSigningData().size());
+
+    // Разбор канонического представления: txId | version | sender | receiver | amount | timestamp | metadata | signature
+    uint32_t position = row.begin + Hash256::SIZE + sizeof(uint8_t);
+    auto nextField = [&](Field &field)
+    {
+        field.length = Encoding::loadU32(arena.data() + position);
+        field.offset = position + sizeof(uint32_t);
+        position = field.offset + field.length;
+    };
+
+    nextField(row.sender);
+    nextField(row.receiver);
+    position += 2 * sizeof(uint64_t);
+    nextField(row.metadata);
+    nextField(row.signature);
+
+    amounts.push_back(tx.getAmount());
+    senderIds.push_back(tx.getSenderId());
+    receiverIds.push_back(tx.getReceiverId());
+    txIds.push_back(tx.getTxId());
+    timestamps.push_back(tx.getTimestamp());
+    rows.push_back(row);
+}
+
+// Реализация TransactionView
+const Hash256 &TransactionView::getTxId() const { return table->txIds[row]; }
+std::string_view TransactionView::getSender() const { return table->fieldView(table->rows[row].sender); }
+std::string_view TransactionView::getReceiver() const { return table->fieldView(table->rows[row].receiver); }
+Timestamp TransactionView::getTimestamp() const { return table->timestamps[row]; }
+std::string_view TransactionView::getMetadata() const { return table->fieldView(table->rows[row].metadata); }
+AccountId TransactionView::getSenderId() const { return table->senderIds[row]; }
+AccountId TransactionView::getReceiverId() const { return table->receiverIds[row]; }
+Amount TransactionView::getAmount() const { return table->amounts[row]; }
+
+CryptoUtils::SignatureView TransactionView::getSignature() const
+{
+    const std::string_view bytes = table->fieldView(table->rows[row].signature);
+    return CryptoUtils::SignatureView(reinterpret_cast<const unsigned char *>(bytes.data()), bytes.size());
+}
+
+std::string_view TransactionView::getSigningData() const
+{
+    const BlockTransactions::Row &layout = table->rows[row];
+    return std::string_view(table->arena.data() + layout.begin, layout.signedEnd - layout.begin);
+}
+
+std::string_view TransactionView::getEncoded() const
+{
+    const BlockTransactions::Row &layout = table->rows[row];
+    return std::string_view(table->arena.data() + layout.begin, layout.end - layout.begin);
+}
+
+std::string TransactionView::toString() const
+{
+    const CryptoUtils::SignatureView signature = getSignature();
+    std::stringstream ss;
+    ss << "txId: " << getTxId() << ", ";
+    ss << "From: " << getSender() << ", ";
+    ss << "To: " << getReceiver() << ", ";
+    ss << "Amount: " << AmountUtils::format(getAmount()) << " BTC\n"
+       << ", ";
+    ss << "Timestamp: " << TimeUtils::toIso8601(getTimestamp()) << ", ";
+    ss << "Metadata: " << getMetadata() << ", ";
+    ss << "Signature: " << CryptoUtils::toHex(signature.data(), signature.size());
+    return ss.str();
+}
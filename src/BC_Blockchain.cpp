@@ -4,6 +4,8 @@
 #include "BC_Transaction.h"
 #include "BC_CryptoUtils.h"
 #include "BC_Utilities.h"
+#include "BC_Target.h"
+#include "BC_Encoding.h"
 
 // Системные библиотеки (только для реализации)
 #include <string>
@@ -12,20 +14,55 @@
 #include <mutex>
 #include <sstream>
 #include <algorithm>
+#include <memory>
+#include <thread>
+#include <stdexcept>
+
+// Формат сохранения цепочки
+const char PERSISTENCE_MAGIC[] = "BCHN";    // Сигнатура файла
+const uint8_t PERSISTENCE_VERSION = 3;      // Версия формата
+
+// Начальная эмиссия генезис-пользователю
+const Amount GENESIS_SUPPLY = AmountUtils::fromCoins(1000);
+
+// Параметры пересчета сложности
+const size_t RETARGET_WINDOW = 5;           // Количество последних блоков для усреднения
+
+// Потоки валидации занимают зарезервированные ядра; без резерва - все ядра, кроме вызывающего
+static unsigned int validationWorkersFor(const MiningScheduler::Config &miningConfig)
+{
+    if (miningConfig.reservedCores > 0)
+        return miningConfig.reservedCores;
+    return std::max(1u, std::thread::hardware_concurrency()) - 1;
+}
 
 // Создание генезис-блока
-Block Blockchain::createGenesisBlock() {
-    balances["Genesis_User"] = 1000;
-    Transaction genesisTx("System", "Genesis_User", 1000);
+std::shared_ptr<Block> Blockchain::createGenesisBlock() {
+    const AccountId genesisId = accounts.intern("Genesis_User").first;
+    balances.assign(accounts.size(), 0);
+    balances[genesisId] = GENESIS_SUPPLY;
+
+    Transaction genesisTx("System", "Genesis_User", GENESIS_SUPPLY);
+    genesisTx.bindAccounts(AccountRegistry::NO_ACCOUNT, genesisId);
     
-    return Block(0, 
-               "0", 
-               {genesisTx}, 
-               balances, 
-               4); // Стартовая сложность майнинга
+    auto genesis = std::make_shared<Block>(0,
+                                           Hash256(),
+                                           BlockTransactions({genesisTx}),
+                                           Block::BalanceDelta{{genesisId, GENESIS_SUPPLY}},
+                                           Block::BalanceSnapshot{{genesisId, GENESIS_SUPPLY}},
+                                           Block::NewAccounts{genesisId, {}},
+                                           params.genesisBits, // Стартовая сложность майнинга
+                                           0);
+    genesis->mineBlock(miningScheduler);
+    committedTxIds.insert(genesisTx.getTxId());
+    return genesis;
 }
 
-Blockchain::Blockchain()
+Blockchain::Blockchain(const MiningScheduler::Config &miningConfig, const ChainParams &chainParams)
+    : params(chainParams),
+      miningScheduler(miningConfig),
+      validationPool(validationWorkersFor(miningScheduler.getConfig()),
+                     miningScheduler.getConfig().pinThreads && miningScheduler.getConfig().reservedCores > 0)
 {
     chain.push_back(createGenesisBlock());
 }
@@ -35,13 +72,12 @@ void Blockchain::addUser(const std::string &username)
 {
     std::lock_guard<std::mutex> lock(balanceMutex);
 
-
-
-    if (balances.count(username) == 0)
+    if (accounts.find(username) == AccountRegistry::NO_ACCOUNT)
     {
         if (Validator::isAddressFormatValid(username))
         {
-            balances[username] = 0;
+            accounts.intern(username);
+            balances.resize(accounts.size(), 0);
         }
         else
         {
@@ -55,201 +91,449 @@ void Blockchain::addUser(const std::string &username)
 }
 
 // Работа с транзакциями
-bool Blockchain::isTransactionValid(const Transaction& tx,
-    const std::string& publicKeyPEM,
-    std::map<std::string, double>& tempBalances) const 
-{   
-    // Системные транзакции не требуют проверки
-    if (tx.getSender() == "System") return true;
-
-    // Базовые проверки данных
-
-    if (tx.getSignature().empty())
+bool Blockchain::verifyTransactionStateless(const Transaction &tx, EVP_PKEY *publicKey, std::string &error)
+{
+    if (!publicKey)
     {
-        ConsoleUI::printError("Missing signature for TX: " + tx.getTxId());
+        error = "Public key not found for sender: " + tx.getSender();
         return false;
     }
 
-    if (tempBalances.count(tx.getSender()) == 0 || tempBalances[tx.getSender()] < tx.getAmount())
+    if (tx.getSignature().empty())
     {
-        ConsoleUI::printError("Insufficient balance for sender: " + tx.getSender());
+        error = "Missing signature for TX: " + tx.getTxId().toHex();
         return false;
     }
 
     if (tx.getAmount() < 0)
     {
-        ConsoleUI::printError("Negative transaction amount for TX: " + tx.getTxId());
+        error = "Negative transaction amount for TX: " + tx.getTxId().toHex();
         return false;
     }
 
-
     if (tx.getReceiver().empty())
     {
-        ConsoleUI::printError("Empty receiver for TX: " + tx.getTxId());
+        error = "Empty receiver for TX: " + tx.getTxId().toHex();
         return false;
     }
 
-    // Валидация адресов
+    // Валидация адреса получателя
     if (!Validator::isAddressFormatValid(tx.getReceiver()))
     {
-        ConsoleUI::printWarning("Receiver address '" + tx.getReceiver() + "' is invalid. Funds may be lost.");
+        error = "Invalid receiver address: " + tx.getReceiver();
+        return false;
     }
 
     // Верификация криптографической подписи
-    std::string dataToVerify = tx.getTxId() + tx.getSender() 
-                               + tx.getReceiver() + std::to_string(tx.getAmount()) 
-                               + tx.getTimestamp() + tx.getMetadata();
-
-    if (!CryptoUtils::verifySignature(dataToVerify, tx.getSignature(), publicKeyPEM))
+    if (!CryptoUtils::verifySignature(tx.getSigningData(), tx.getSignature(), publicKey))
     {
-        ConsoleUI::printError("Signature INVALID for TX: " + tx.getTxId());
+        error = "Signature INVALID for TX: " + tx.getTxId().toHex();
         return false;
     }
-    else
-    {
-        ConsoleUI::printSuccess("Signature valid for TX: " + tx.getTxId());
-    }
 
     return true;
 }
 
+bool Blockchain::admitTransaction(const Transaction &tx, const PublicKeyCache::KeyEntry &senderKey,
+                                  std::string &error) const
+{
+    // Подпись уже проверена при приеме в пул тем же ключом - повторная проверка не нужна
+    const SignatureCache::Entry entry{SignatureCache::signatureDigest(tx.getSigningData(), tx.getSignature()),
+                                      senderKey.fingerprint};
+    if (senderKey.key && signatureCache.contains(tx.getTxId(), entry))
+        return true;
 
-// Добавление блоков
-void Blockchain::addBlock(const std::vector<Transaction> &transactions, 
-                                        const std::map<std::string, 
-                                        std::string> &publicKeys)
+    if (!verifyTransactionStateless(tx, senderKey.key.get(), error))
+        return false;
+
+    signatureCache.insert(tx.getTxId(), entry);
+    return true;
+}
+
+bool Blockchain::applyTransactions(const BlockTransactions &transactions, LedgerOverlay &ledger,
+                                   size_t *failedIndex) const
 {
-    std::lock_guard<std::mutex> lock(balanceMutex);
-    std::map<std::string, double> tempBalances = balances;
+    const std::vector<Amount> &amounts = transactions.getAmounts();
+    const std::vector<AccountId> &senderIds = transactions.getSenderIds();
+    const std::vector<AccountId> &receiverIds = transactions.getReceiverIds();
 
-    // Предварительная обработка транзакций
-    for (const auto &tx : transactions)
+    for (size_t i = 0; i < transactions.size(); ++i)
     {
-
-        // Поиск публичного ключа отправителя
-        auto it = publicKeys.find(tx.getSender());
-        if (it == publicKeys.end())
+        const AccountId senderId = senderIds[i];
+        const Amount senderBalance = senderId == AccountRegistry::NO_ACCOUNT ? 0 : ledger.get(senderId);
+        if (senderId == AccountRegistry::NO_ACCOUNT || senderBalance < amounts[i])
         {
-            ConsoleUI::printError("Public key not found for sender: " + tx.getSender());
-            ConsoleUI::printError("Block not added.");
-            return;
+            ConsoleUI::printError("Insufficient balance for sender: " + std::string(transactions[i].getSender()));
+            ConsoleUI::printError("Transaction " + transactions[i].getTxId().toHex() + " is invalid. Block not added.");
+            if (failedIndex)
+                *failedIndex = i;
+            return false;
         }
 
-        // Валидация получателя
-        if (!Validator::isAddressFormatValid(tx.getReceiver()))
+        // Списание до зачисления: перевод самому себе не меняет баланс
+        ledger.set(senderId, senderBalance - amounts[i]);
+        Amount newReceiverBalance = 0;
+        if (!AmountUtils::add(ledger.get(receiverIds[i]), amounts[i], newReceiverBalance))
         {
-            ConsoleUI::printError("Invalid receiver address: " + tx.getReceiver());
-            return;
+            ConsoleUI::printError("Balance overflow for receiver: " + std::string(transactions[i].getReceiver()));
+            ConsoleUI::printError("Transaction " + transactions[i].getTxId().toHex() + " is invalid. Block not added.");
+            if (failedIndex)
+                *failedIndex = i;
+            return false;
         }
 
-        // Валидация транзакции
-        if (!isTransactionValid(tx, it->second, tempBalances))
+        ledger.set(receiverIds[i], newReceiverBalance);
+    }
+    return true;
+}
+
+bool Blockchain::checkUniqueTxIdsLocked(const BlockTransactions &transactions, size_t *failedIndex) const
+{
+    std::unordered_set<Hash256> batch;
+    batch.reserve(transactions.size());
+    for (size_t i = 0; i < transactions.size(); ++i)
+    {
+        const Hash256 &txId = transactions[i].getTxId();
+        const bool committed = committedTxIds.count(txId) != 0;
+        if (committed || !batch.insert(txId).second)
         {
-            ConsoleUI::printError("Transaction " + tx.getTxId() + " is invalid. Block not added.");
-            return;
+            ConsoleUI::printError("Transaction " + txId.toHex() +
+                                  (committed ? " is already in the blockchain" : " is repeated in the block") +
+                                  ". Block not added.");
+            if (failedIndex)
+                *failedIndex = i;
+            return false;
         }
+    }
+    return true;
+}
 
-        // Обновление временных балансов
-        tempBalances[tx.getSender()] -= tx.getAmount();
-        tempBalances[tx.getReceiver()] += tx.getAmount(); // Автоматически создает запись, если получателя нет
+void Blockchain::bindAccountsLocked(BlockTransactions &transactions, LedgerOverlay &ledger) const
+{
+    // Адрес ищется в реестре, затем среди счетов, уже созданных этим блоком
+    auto lookup = [&](std::string_view address)
+    {
+        const AccountId id = accounts.find(address);
+        return id != AccountRegistry::NO_ACCOUNT ? id : ledger.findProvisional(address);
+    };
 
-        // Авторегистрация новых пользователей
-        if (balances.count(tx.getReceiver()) == 0)
+    for (size_t i = 0; i < transactions.size(); ++i)
+    {
+        const TransactionView tx = transactions[i];
+        AccountId receiverId = lookup(tx.getReceiver());
+        if (receiverId == AccountRegistry::NO_ACCOUNT)
         {
-            ConsoleUI::printWarning("Receiver " + tx.getReceiver() + " not registered! Automatically creating account.");
-            balances[tx.getReceiver()] = 0; 
+            receiverId = ledger.provisionalAccount(tx.getReceiver()).first;
+            ConsoleUI::printWarning("Receiver " + std::string(tx.getReceiver()) + " not registered! Account will be created with the block.");
         }
+        transactions.bindAccounts(i, lookup(tx.getSender()), receiverId);
     }
+}
+
+bool Blockchain::isCheckpointHeight(size_t height) const
+{
+    return height == 0 || (params.checkpointInterval > 0 && height % params.checkpointInterval == 0);
+}
 
-    // Фильтрация нулевых балансов
-    for (auto it = tempBalances.begin(); it != tempBalances.end();)
+Block::BalanceSnapshot Blockchain::makeCheckpoint(const LedgerOverlay &ledger, size_t accountCount)
+{
+    Block::BalanceSnapshot snapshot;
+    for (AccountId id = 0; id < accountCount; ++id)
     {
-        if (it->second == 0 && balances.find(it->first) == balances.end())
+        const Amount balance = ledger.get(id);
+        if (balance != 0)
         {
-            it = tempBalances.erase(it);
+            snapshot.emplace_back(id, balance);
         }
-        else
+    }
+    return snapshot;
+}
+
+// Подготовка шаблона блока
+std::shared_ptr<Block> Blockchain::createBlockTemplate(const std::vector<Transaction> &transactions,
+                                                       const PublicKeyCache &publicKeys,
+                                                       std::vector<size_t> *rejected)
+{
+    // Этап 1: проверки без состояния параллельно и без блокировки цепочки
+    std::vector<std::string> errors(transactions.size());
+    std::vector<uint8_t> verified(transactions.size(), 0);
+    validationPool.parallelFor(transactions.size(), [&](size_t i)
+                               {
+                                   const Transaction &tx = transactions[i];
+                                   verified[i] = admitTransaction(tx, publicKeys.findEntry(tx.getSender()), errors[i]); });
+
+    bool admitted = true;
+    for (size_t i = 0; i < transactions.size(); ++i)
+    {
+        if (!verified[i])
         {
-            ++it;
+            ConsoleUI::printError(errors[i]);
+            ConsoleUI::printError("Transaction " + transactions[i].getTxId().toHex() + " is invalid. Block not added.");
+            if (rejected)
+                rejected->push_back(i);
+            admitted = false;
+            continue;
         }
+        ConsoleUI::printSuccess("Signature valid for TX: " + transactions[i].getTxId().toHex());
+    }
+    if (!admitted)
+    {
+        return nullptr;
+    }
+
+    // Этап 2: привязка строк блока к счетам и последовательное применение к балансам
+    BlockTransactions table(transactions);
+    std::lock_guard<std::mutex> lock(balanceMutex);
+    size_t failedIndex = 0;
+    if (!checkUniqueTxIdsLocked(table, &failedIndex))
+    {
+        if (rejected)
+            rejected->push_back(failedIndex);
+        return nullptr;
     }
 
-    // Сохранение актуальных балансов
-    balances = tempBalances;
+    // Изменения и новые счета записываются в слой поверх подтвержденных балансов; при отказе слой отбрасывается
+    LedgerOverlay pending(balances);
+    bindAccountsLocked(table, pending);
+    if (!applyTransactions(table, pending, &failedIndex))
+    {
+        if (rejected)
+            rejected->push_back(failedIndex);
+        return nullptr;
+    }
 
-    // Фильтрация балансов перед сохранением в блок
-    std::map<std::string, double> snapshot;
-    for (const auto &[user, balance] : balances)
+    // Блок хранит только приращения затронутых счетов; полный снимок - раз в checkpointInterval блоков
+    const Block &latestBlock = *chain.back();
+    const size_t height = static_cast<size_t>(latestBlock.getIndex()) + 1;
+    std::optional<Block::BalanceSnapshot> checkpoint;
+    if (isCheckpointHeight(height))
     {
-        // Включаем только участников транзакций или с ненулевым балансом
-        bool isInvolved = std::any_of(transactions.begin(), transactions.end(),
-                                      [&](const Transaction &tx)
-                                      {
-                                          return tx.getSender() == user || tx.getReceiver() == user;
-                                      });
+        checkpoint = makeCheckpoint(pending, accounts.size() + pending.newAccounts().size());
+    }
 
-        if (balance != 0 || isInvolved)
-        {
-            snapshot[user] = balance;
-        }
+    // Шаблон ссылается на текущую вершину цепочки; майнинг выполняется вне блокировки
+    return std::make_shared<Block>(static_cast<int>(height),
+                                   latestBlock.getHash(),
+                                   std::move(table),
+                                   pending.deltas(),
+                                   std::move(checkpoint),
+                                   Block::NewAccounts{pending.firstProvisionalId(), pending.newAccounts()},
+                                   calculateNextTargetBits(),
+                                   latestBlock.getSolveTimeMs());
+}
+
+// Добавление добытого блока
+const char *Blockchain::staleReasonLocked(const Block &block) const
+{
+    // Шаблон устарел, если вершина цепочки изменилась во время майнинга
+    const Block &latestBlock = *chain.back();
+    if (block.getPreviousHash() != latestBlock.getHash() || block.getIndex() != latestBlock.getIndex() + 1)
+    {
+        return "chain tip has changed";
     }
 
-    // Создание и добавление нового блока
-    Block latestBlock = getLatestBlock();
-    Block newBlock(latestBlock.getIndex() + 1,
-                   latestBlock.getHash(),
-                   transactions,
-                   snapshot,
-                   latestBlock.getDifficulty());
+    // Временные id новых счетов действительны, только если реестр не рос после сборки шаблона
+    const Block::NewAccounts &newAccounts = block.getNewAccounts();
+    if (!newAccounts.addresses.empty() && newAccounts.firstId != accounts.size())
+    {
+        return "account registry has changed";
+    }
+    return nullptr;
+}
 
-    ConsoleUI::printInfo("Balance snapshot for block " + std::to_string(newBlock.getIndex()));
-    for (const auto &[user, balance] : snapshot)
+bool Blockchain::isTemplateStale(const Block &block) const
+{
+    std::lock_guard<std::mutex> lock(balanceMutex);
+    return staleReasonLocked(block) != nullptr;
+}
+
+bool Blockchain::appendBlock(std::shared_ptr<const Block> minedBlock)
+{
+    std::lock_guard<std::mutex> lock(balanceMutex);
+    const Block &block = *minedBlock;
+
+    if (!block.isMined())
+    {
+        ConsoleUI::printError("Block " + std::to_string(block.getIndex()) + " has no Proof-of-Work solution");
+        return false;
+    }
+
+    if (const char *reason = staleReasonLocked(block))
     {
-        ConsoleUI::printDefault("  " + user + ": " + std::to_string(balance));
+        ConsoleUI::printWarning("Block " + std::to_string(block.getIndex()) + " is stale: " + reason);
+        return false;
+    }
+    const Block::NewAccounts &newAccounts = block.getNewAccounts();
+
+    // Цель должна следовать из заголовков, иначе майнер мог бы произвольно снижать сложность
+    if (block.getTargetBits() != expectedTargetBits(chain, chain.size(), block.getParentSolveTimeMs()))
+    {
+        ConsoleUI::printError("Block " + std::to_string(block.getIndex()) + " has unexpected target bits");
+        return false;
     }
 
-    chain.push_back(newBlock);
+    // Повторное применение к слою стоит O(размера блока); балансы меняются только при успехе
+    LedgerOverlay pending(balances);
+    if (!checkUniqueTxIdsLocked(block.getTransactions()) || !applyTransactions(block.getTransactions(), pending))
+    {
+        return false;
+    }
+    for (const std::string &address : newAccounts.addresses)
+    {
+        accounts.intern(address);
+    }
+    pending.commit(balances);
+    balances.resize(accounts.size(), 0);
+    for (const auto &tx : block.getTransactions())
+    {
+        committedTxIds.insert(tx.getTxId());
+    }
+
+    ConsoleUI::printInfo("Balance changes for block " + std::to_string(block.getIndex()));
+    for (const auto &[id, delta] : block.getBalanceDelta())
+    {
+        ConsoleUI::printDefault("  " + accounts.nameOf(id) + ": " + (delta > 0 ? "+" : "") + AmountUtils::format(delta)
+                                + " (balance: " + AmountUtils::format(balances[id]) + ")");
+    }
+
+    chain.push_back(std::move(minedBlock));
     ConsoleUI::printSuccess("Transaction successfully added to blockchain!");
+    return true;
+}
+
+// Синхронное добавление блока
+void Blockchain::addBlock(const std::vector<Transaction> &transactions, 
+                                        const PublicKeyCache &publicKeys)
+{
+    std::shared_ptr<Block> newBlock = createBlockTemplate(transactions, publicKeys);
+    if (!newBlock)
+        return;
+
+    newBlock->mineBlock(miningScheduler);
+    appendBlock(std::move(newBlock));
+}
+
+MiningScheduler &Blockchain::getMiningScheduler()
+{
+    return miningScheduler;
+}
+
+const AccountRegistry &Blockchain::getAccountRegistry() const
+{
+    return accounts;
+}
+
+bool Blockchain::containsTransaction(const Hash256 &txId) const
+{
+    std::lock_guard<std::mutex> lock(balanceMutex);
+    return committedTxIds.count(txId) != 0;
+}
+
+const SignatureCache &Blockchain::getSignatureCache() const
+{
+    return signatureCache;
 }
 
 // Валидация цепочки
-bool Blockchain::isChainValid(const std::map<std::string, std::string> &publicKeys) const
+bool Blockchain::isChainValid(const PublicKeyCache &publicKeys) const
+{
+    return isChainValid(publicKeys, false);
+}
+
+bool Blockchain::isChainValid(const PublicKeyCache &publicKeys, bool fullVerification) const
 {
+    // Снимок цепочки берется под блокировкой; блоки неизменяемы, поэтому дальше она не нужна
+    std::vector<std::shared_ptr<const Block>> blocks;
+    size_t accountCount = 0;
+    {
+        std::lock_guard<std::mutex> lock(balanceMutex);
+        blocks = chain;
+        accountCount = accounts.size();
+    }
+
     ConsoleUI::printInfo("[Blockchain Validation] Starting...");
-    ConsoleUI::printInfo("Total blocks to validate: " + std::to_string(chain.size()) + "\n");
+    ConsoleUI::printInfo("Total blocks to validate: " + std::to_string(blocks.size()) + "\n");
 
-    std::map<std::string, double> tempBalances;
+    // Подписи всех транзакций проверяются параллельно в пуле валидации, до последовательного прохода
+    std::vector<size_t> firstTx(blocks.size() + 1, 0);
+    for (size_t i = 0; i < blocks.size(); ++i)
+    {
+        firstTx[i + 1] = firstTx[i] + blocks[i]->getTransactions().size();
+    }
+
+    std::vector<SignatureCheck> signatures(firstTx.back(), SignatureCheck::NotApplicable);
+    validationPool.parallelFor(signatures.size(), [&](size_t k)
+                               {
+                                   // Блок, содержащий k-ю транзакцию цепочки (пустые блоки пропускаются)
+                                   const size_t i = static_cast<size_t>(std::upper_bound(firstTx.begin(), firstTx.end(), k) - firstTx.begin()) - 1;
+                                   signatures[k] = checkSignature(blocks[i]->getTransactions()[k - firstTx[i]], publicKeys, fullVerification); });
+
+    // Балансы по AccountId накапливаются от генезиса; каждый блок применяется через слой
+    std::vector<Amount> tempBalances(accountCount, 0);
+    std::unordered_set<Hash256> seenTxIds;
     bool isValid = true;
 
-    for (size_t i = 0; i < chain.size(); ++i)
+    for (size_t i = 0; i < blocks.size(); ++i)
     {
-        const Block &current = chain[i];
+        const Block &current = *blocks[i];
+        const std::string hashHex = current.getHash().toHex();
         ConsoleUI::printDefault("Checking Block #" + std::to_string(current.getIndex()) 
-                                        + " (Hash: " + current.getHash().substr(0, 12) 
-                                        + "..." + current.getHash().substr(56) + ")");
+                                        + " (Hash: " + hashHex.substr(0, 12) 
+                                        + "..." + hashHex.substr(56) + ")");
 
+        LedgerOverlay pending(tempBalances);
+
+        // Проверка Proof-of-Work: бинарный хеш сравнивается с 256-битной целью
+        const Hash256 digest = current.calculateBlockHash();
+        const Target256 target = Target256::fromCompact(current.getTargetBits());
+        ConsoleUI::printDefault("Checking Proof-of-Work...", false);
+        if (target.isMetBy(digest.data()))
+        {
+            std::stringstream bitsHex;
+            bitsHex << std::hex << current.getTargetBits();
+            ConsoleUI::printDefault("Valid (Target bits: 0x" + bitsHex.str() 
+                                    + ", Leading zero bits: " + std::to_string(target.leadingZeroBits()) + ")");
+        }
+        else
+        {
+            ConsoleUI::printDefault("Invalid! Hash above target " + target.toHex().substr(0, 16) + "...");
+            isValid = false;
+        }
+
+        // Проверка цели: точное совпадение с пересчетом по данным заголовков
+        ConsoleUI::printDefault("Checking target... ", false);
+        const uint32_t expectedBits = expectedTargetBits(blocks, i, current.getParentSolveTimeMs());
+        bool targetValid = target != Target256() && target <= Target256::powLimit() &&
+                           current.getTargetBits() == expectedBits;
+
+        // Заявленное время поиска предыдущего блока не превышает интервал между их шаблонами
         if (i > 0)
         {
-            tempBalances = chain[i - 1].getBalanceSnapshot();
+            const Timestamp interval = current.getTimestamp() - blocks[i - 1]->getTimestamp();
+            targetValid = targetValid && interval > 0 &&
+                          current.getParentSolveTimeMs() <= static_cast<uint64_t>(interval) / 1000000;
+        }
+        else
+        {
+            targetValid = targetValid && current.getParentSolveTimeMs() == 0;
         }
 
-        // Проверка Proof-of-Work
-        ConsoleUI::printDefault("Checking Proof-of-Work...", false);
-        if (current.getHash().substr(0, current.getDifficulty()) == std::string(current.getDifficulty(), '0'))
+        if (targetValid)
         {
-            ConsoleUI::printDefault("Valid (Difficulty: " + std::to_string(current.getDifficulty()) 
-                                    + ", Leading zeros: " + current.getHash().substr(0, current.getDifficulty()) + ")");
+            ConsoleUI::printDefault("Valid");
         }
         else
         {
-            ConsoleUI::printDefault("Invalid! First " + std::to_string(current.getDifficulty()) 
-                                    + " chars: " + current.getHash().substr(0, current.getDifficulty()));
+            std::stringstream expectedHex;
+            expectedHex << std::hex << expectedBits;
+            ConsoleUI::printDefault("Invalid target adjustment! Expected bits: 0x" + expectedHex.str()
+                                    + ", parent solve time: " + std::to_string(current.getParentSolveTimeMs()) + " ms");
             isValid = false;
         }
 
         // Проверка хеша блока
         ConsoleUI::printDefault("Checking block hash... ", false);
-        if (current.getHash() == current.calculateBlockHash())
+        if (current.getHash() == digest)
         {
             ConsoleUI::printDefault("Valid");
         }
@@ -263,55 +547,75 @@ bool Blockchain::isChainValid(const std::map<std::string, std::string> &publicKe
         if (i > 0)
         {
             ConsoleUI::printDefault("Checking chain link... ", false);
-            if (current.getPreviousHash() == chain[i - 1].getHash())
+            if (current.getPreviousHash() == blocks[i - 1]->getHash())
             {
-                ConsoleUI::printDefault("Valid (Prev hash: " + chain[i - 1].getHash().substr(0, 12) + "...)");
+                ConsoleUI::printDefault("Valid (Prev hash: " + blocks[i - 1]->getHash().toHex().substr(0, 12) + "...)");
             }
             else
             {
-                ConsoleUI::printDefault("Broken link! Expected: " + chain[i - 1].getHash().substr(0, 12) 
-                                        + "...\n" + "                  Actual: " + current.getPreviousHash().substr(0, 12) + "...");
+                ConsoleUI::printDefault("Broken link! Expected: " + blocks[i - 1]->getHash().toHex().substr(0, 12) 
+                                        + "...\n" + "                  Actual: " + current.getPreviousHash().toHex().substr(0, 12) + "...");
                 isValid = false;
             }
         }
 
         // Проверка транзакций
         ConsoleUI::printDefault("Transactions (" + std::to_string(current.getTransactions().size()) + "):");
+        size_t signatureIndex = firstTx[i];
         for (const auto &tx : current.getTransactions())
         {
-            ConsoleUI::printDefault("TX " + tx.getTxId().substr(0, 8) + "... | " + std::to_string(tx.getAmount()) 
-                                    + " BTC " + tx.getSender().substr(0, 5) + " - " + tx.getReceiver().substr(0, 5) + " | ", false);
+            const SignatureCheck signature = signatures[signatureIndex++];
+            ConsoleUI::printDefault("TX " + tx.getTxId().toHex().substr(0, 8) + "... | " + AmountUtils::format(tx.getAmount()) 
+                                    + " BTC " + std::string(tx.getSender().substr(0, 5)) + " - "
+                                    + std::string(tx.getReceiver().substr(0, 5)) + " | ", false);
 
-            if (tempBalances.find(tx.getReceiver()) == tempBalances.end())
+            // Повтор транзакции из предыдущих блоков или этого же блока
+            if (!seenTxIds.insert(tx.getTxId()).second)
             {
-                tempBalances[tx.getReceiver()] = 0;
+                ConsoleUI::printDefault("Duplicate transaction!");
+                isValid = false;
+                continue;
             }
 
-            if (tx.getSender() == "System")
+            // Идентификаторы счетов должны соответствовать адресам транзакции
+            const AccountId senderId = tx.getSenderId();
+            const AccountId receiverId = tx.getReceiverId();
+            const bool isSystem = tx.getSender() == "System" && senderId == AccountRegistry::NO_ACCOUNT;
+            if (receiverId >= accountCount || accounts.nameOf(receiverId) != tx.getReceiver() ||
+                (!isSystem && (senderId >= accountCount || accounts.nameOf(senderId) != tx.getSender())))
+            {
+                ConsoleUI::printDefault("Unknown account!");
+                isValid = false;
+                continue;
+            }
+
+            if (isSystem)
             {
                 ConsoleUI::printDefault("System transaction (skipped checks)");
-                tempBalances[tx.getReceiver()] += tx.getAmount();
+                Amount credited = 0;
+                if (!AmountUtils::add(pending.get(receiverId), tx.getAmount(), credited))
+                {
+                    ConsoleUI::printDefault("Balance overflow for receiver: " + accounts.nameOf(receiverId));
+                    isValid = false;
+                }
+                pending.set(receiverId, credited);
                 continue;
             }
 
-            // Проверка подписи
-            auto it = publicKeys.find(tx.getSender());
-            if (it == publicKeys.end())
+            // Проверка подписи (выполнена параллельно выше)
+            if (signature == SignatureCheck::MissingKey)
             {
                 ConsoleUI::printDefault("Missing public key!");
                 isValid = false;
                 continue;
             }
-            else
+            ConsoleUI::printDefault("Public key VALID!");
+
+            if (signature == SignatureCheck::Cached)
             {
-                ConsoleUI::printDefault("Public key VALID!");
+                ConsoleUI::printDefault("Valid sig (cached) | ", false);
             }
-
-            std::string dataToVerify = tx.getTxId() + tx.getSender() + tx.getReceiver() 
-                                       + std::to_string(tx.getAmount()) 
-                                       + tx.getTimestamp() + tx.getMetadata();
-
-            if (CryptoUtils::verifySignature(dataToVerify, tx.getSignature(), it->second))
+            else if (signature == SignatureCheck::Valid)
             {
                 ConsoleUI::printDefault("Valid sig | ", false);
             }
@@ -322,161 +626,241 @@ bool Blockchain::isChainValid(const std::map<std::string, std::string> &publicKe
             }
 
             // Проверка баланса
-            if (tempBalances[tx.getSender()] >= tx.getAmount())
+            const Amount senderBalance = pending.get(senderId);
+            if (senderBalance >= tx.getAmount())
             {
-                ConsoleUI::printDefault("Balance OK (" + std::to_string(tempBalances[tx.getSender()]) 
-                                        + " - " + std::to_string(tempBalances[tx.getSender()] - tx.getAmount()) + ")");
+                ConsoleUI::printDefault("Balance OK (" + AmountUtils::format(senderBalance) 
+                                        + " - " + AmountUtils::format(senderBalance - tx.getAmount()) + ")");
             }
             else
             {
-                ConsoleUI::printDefault("Insufficient funds for sender: " + tx.getSender());
-                ConsoleUI::printDefault("Expected balances:");
-                for (const auto &[k, v] : current.getBalanceSnapshot())
-                {
-                    ConsoleUI::printDefault("  " + k + ": " + std::to_string(v));
-                }
-                ConsoleUI::printDefault("Actual balances:");
-                for (const auto &[k, v] : tempBalances)
-                {
-                    ConsoleUI::printDefault("  " + k + ": " + std::to_string(v));
-                }
-                ConsoleUI::printDefault("Available balance: " + std::to_string(tempBalances[tx.getSender()]));
+                ConsoleUI::printDefault("Insufficient funds for sender: " + accounts.nameOf(senderId));
+                ConsoleUI::printDefault("Available balance: " + AmountUtils::format(senderBalance));
                 isValid = false;
             }
 
-            // Обновление баланса
-            tempBalances[tx.getSender()] -= tx.getAmount();
-            tempBalances[tx.getReceiver()] += tx.getAmount();
-        }
-
-        // Создание отфильтрованного снапшота
-        std::map<std::string, double> filteredTemp;
-        for (const auto &[user, balance] : tempBalances)
-        {
-            bool isInvolved = std::any_of(
-                current.getTransactions().begin(),
-                current.getTransactions().end(),
-                [&](const Transaction &tx)
-                {
-                    return tx.getSender() == user || tx.getReceiver() == user;
-                });
-
-            if (balance != 0 || isInvolved)
-            {
-                filteredTemp[user] = balance;
-            }
-        }
-
-        // Очищаем нулевые балансы не участников
-        for (auto it = filteredTemp.begin(); it != filteredTemp.end();)
-        {
-            if (it->second == 0 &&
-                std::none_of(current.getTransactions().begin(),
-                             current.getTransactions().end(),
-                             [&](const Transaction &tx)
-                             {
-                                 return tx.getSender() == it->first || tx.getReceiver() == it->first;
-                             }))
+            // Обновление баланса с проверкой переполнения (списание до зачисления)
+            Amount debited = 0;
+            Amount credited = 0;
+            if (!AmountUtils::subtract(senderBalance, tx.getAmount(), debited))
             {
-                it = filteredTemp.erase(it);
+                ConsoleUI::printDefault("Balance overflow in TX: " + tx.getTxId().toHex());
+                isValid = false;
+                continue;
             }
-            else
+            pending.set(senderId, debited);
+            if (!AmountUtils::add(pending.get(receiverId), tx.getAmount(), credited))
             {
-                ++it;
+                ConsoleUI::printDefault("Balance overflow in TX: " + tx.getTxId().toHex());
+                isValid = false;
+                continue;
             }
+            pending.set(receiverId, credited);
         }
 
-        // Проверяем снапшот блока против отфильтрованных данных
-        ConsoleUI::printDefault("Checking balance snapshot... ", false);
-        if (current.getBalanceSnapshot() == filteredTemp)
+        // Приращения блока сверяются с повторным применением его транзакций
+        const Block::BalanceDelta actualDelta = pending.deltas();
+        ConsoleUI::printDefault("Checking balance changes... ", false);
+        if (current.getBalanceDelta() == actualDelta)
         {
-            ConsoleUI::printDefault("Matched");
+            ConsoleUI::printDefault("Matched (" + std::to_string(actualDelta.size()) + " accounts)");
         }
         else
         {
             ConsoleUI::printDefault("Mismatch!");
-            ConsoleUI::printDefault("Expected balances (from block):");
-            for (const auto &[k, v] : current.getBalanceSnapshot())
+            ConsoleUI::printDefault("Expected changes (from block):");
+            for (const auto &[id, delta] : current.getBalanceDelta())
             {
-                ConsoleUI::printDefault("  " + k + ": " + std::to_string(v) + "\n", false);
+                ConsoleUI::printDefault("  " + accounts.nameOf(id) + ": " + AmountUtils::format(delta));
             }
-            ConsoleUI::printDefault("Actual filtered balances:");
-            for (const auto &[k, v] : filteredTemp)
+            ConsoleUI::printDefault("Actual changes:");
+            for (const auto &[id, delta] : actualDelta)
             {
-                ConsoleUI::printDefault("  " + k + ": " + std::to_string(v) + "\n", false);
+                ConsoleUI::printDefault("  " + accounts.nameOf(id) + ": " + AmountUtils::format(delta));
             }
             isValid = false;
         }
 
-        // Обновляем для следующего блока
-        tempBalances = filteredTemp;
+        // Контрольная точка должна совпадать с накопленными балансами
+        if (current.hasCheckpoint())
+        {
+            ConsoleUI::printDefault("Checking balance checkpoint... ", false);
+            if (current.getCheckpoint() == makeCheckpoint(pending, accountCount))
+            {
+                ConsoleUI::printDefault("Matched (" + std::to_string(current.getCheckpoint().size()) + " accounts)");
+            }
+            else
+            {
+                ConsoleUI::printDefault("Mismatch!");
+                isValid = false;
+            }
+        }
+        else if (isCheckpointHeight(i))
+        {
+            ConsoleUI::printDefault("Missing balance checkpoint!");
+            isValid = false;
+        }
+        pending.commit(tempBalances);
 
         ConsoleUI::printDivider();
     }
 
     ConsoleUI::printDefault("\nValidation " + (isValid ? std::string("SUCCESSFUL") : std::string("FAILED")) 
-                            + " | Blocks: " + std::to_string(chain.size()) + " | Total TX: " 
-                            + std::to_string(countAllTransactions()) + "\n\n");
+                            + " | Blocks: " + std::to_string(blocks.size()) + " | Total TX: " 
+                            + std::to_string(firstTx.back()) + "\n\n");
 
     return isValid;
 }
 
+Blockchain::SignatureCheck Blockchain::checkSignature(const TransactionView &tx, const PublicKeyCache &publicKeys,
+                                                      bool fullVerification) const
+{
+    // Системная транзакция и неизвестный отправитель разбираются при последовательном проходе
+    if (tx.getSenderId() == AccountRegistry::NO_ACCOUNT)
+        return SignatureCheck::NotApplicable;
+
+    const PublicKeyCache::KeyEntry senderKey = publicKeys.findEntry(accounts.nameOf(tx.getSenderId()));
+    if (!senderKey.key)
+        return SignatureCheck::MissingKey;
+
+    // Подпись, проверенная при допуске, не проверяется повторно
+    const std::string_view dataToVerify = tx.getSigningData();
+    const SignatureCache::Entry cacheEntry{SignatureCache::signatureDigest(dataToVerify, tx.getSignature()),
+                                           senderKey.fingerprint};
+    if (!fullVerification && signatureCache.contains(tx.getTxId(), cacheEntry))
+        return SignatureCheck::Cached;
+
+    if (!CryptoUtils::verifySignature(dataToVerify, tx.getSignature(), senderKey.key.get()))
+        return SignatureCheck::Invalid;
+
+    signatureCache.insert(tx.getTxId(), cacheEntry);
+    return SignatureCheck::Valid;
+}
+
 // Вспомогательные методы
 
-Block Blockchain::getLatestBlock() const
+std::shared_ptr<const Block> Blockchain::getLatestBlock() const
 {
+    std::lock_guard<std::mutex> lock(balanceMutex);
     return chain.back();
 }
 
+uint32_t Blockchain::expectedTargetBits(const std::vector<std::shared_ptr<const Block>> &blocks, size_t height,
+                                        uint64_t parentSolveTimeMs) const
+{
+    if (height == 0)
+        return params.genesisBits;
+
+    // Время поиска блока j записано в заголовке блока j + 1; для последнего блока окна - в новом блоке
+    const size_t window = std::min(RETARGET_WINDOW, height);
+    uint64_t totalMs = parentSolveTimeMs;
+    for (size_t i = height - window + 1; i < height; ++i)
+    {
+        totalMs += blocks[i]->getParentSolveTimeMs();
+    }
+    const uint64_t averageMs = totalMs / window;
+
+    return Target256::retarget(blocks[height - 1]->getTargetBits(),
+                               static_cast<uint32_t>(std::min<uint64_t>(averageMs, UINT32_MAX)),
+                               params.targetSolveTimeMs);
+}
+
+uint32_t Blockchain::calculateNextTargetBits() const
+{
+    const uint64_t parentSolveTimeMs = chain.back()->getSolveTimeMs();
+    const uint32_t currentBits = chain.back()->getTargetBits();
+    const uint32_t nextBits = expectedTargetBits(chain, chain.size(), parentSolveTimeMs);
+    if (nextBits != currentBits)
+    {
+        ConsoleUI::printMining("Difficulty retarget: last solve time " + std::to_string(parentSolveTimeMs) + " ms, target " +
+                               std::to_string(Target256::fromCompact(nextBits).leadingZeroBits()) + " zero bits");
+    }
+    return nextBits;
+}
+
 std::string Blockchain::serialize() const
 {
-    std::stringstream ss;
+    std::lock_guard<std::mutex> lock(balanceMutex);
+    std::string out(PERSISTENCE_MAGIC);
+    Encoding::appendU8(out, PERSISTENCE_VERSION);
+    Encoding::appendU32(out, static_cast<uint32_t>(chain.size()));
+
+    // Заголовок блока уже содержит канонические представления его транзакций
     for (const auto &block : chain)
     {
-        ss << "Index: " << block.getIndex() << "\n";
-        ss << "Timestamp: " << block.getTimestamp() << "\n";
-        ss << "Transactions:\n";
-        for (const auto &tx : block.getTransactions())
-        {
-            ss << "  - " << tx.toString() << "\n";
-        }
-        ss << "Previous Hash: " << block.getPreviousHash() << "\n";
-        ss << "Hash: " << block.getHash() << "\n";
-        ss << "--------------------------\n";
+        Encoding::appendString(out, block->serializeHeader());
+        block->getHash().appendTo(out);
     }
-    return ss.str();
+    return out;
 }
 
 size_t Blockchain::countAllTransactions() const
+{
+    std::lock_guard<std::mutex> lock(balanceMutex);
+    return countTransactionsLocked();
+}
+
+size_t Blockchain::countTransactionsLocked() const
 {
     size_t count = 0;
     for (const auto &block : chain)
     {
-        count += block.getTransactions().size();
+        count += block->getTransactions().size();
     }
     return count;
 }
 
 void Blockchain::printBlockchain() const
 {
+    std::lock_guard<std::mutex> lock(balanceMutex);
     for (const auto &block : chain)
     {
-        block.printBlock();
+        block->printBlock();
     }
 }
 
 // Метод для получения баланса конкретного пользователя
-double Blockchain::getBalance(const std::string &username) const
+Amount Blockchain::getBalance(const std::string &username) const
 {
-    auto it = balances.find(username);
-    if (it != balances.end())
-        return it->second;
-    else
-        return 0;
+    std::lock_guard<std::mutex> lock(balanceMutex);
+    const AccountId id = accounts.find(username);
+    return id < balances.size() ? balances[id] : 0;
+}
+
+std::vector<Amount> Blockchain::getBalancesAtHeight(size_t height) const
+{
+    std::lock_guard<std::mutex> lock(balanceMutex);
+    if (height >= chain.size())
+    {
+        throw std::out_of_range("No block at height " + std::to_string(height) 
+                                + " (chain length: " + std::to_string(chain.size()) + ")");
+    }
+
+    // Ближайшая контрольная точка не выше height; генезис-блок всегда ее содержит
+    size_t checkpointHeight = height;
+    while (!chain[checkpointHeight]->hasCheckpoint())
+    {
+        --checkpointHeight;
+    }
+
+    std::vector<Amount> ledger(accounts.size(), 0);
+    for (const auto &[id, balance] : chain[checkpointHeight]->getCheckpoint())
+    {
+        ledger[id] = balance;
+    }
+    for (size_t i = checkpointHeight + 1; i <= height; ++i)
+    {
+        for (const auto &[id, delta] : chain[i]->getBalanceDelta())
+        {
+            ledger[id] += delta;
+        }
+    }
+    return ledger;
 }
 
 void Blockchain::drawChain() const
 {
+    std::lock_guard<std::mutex> lock(balanceMutex);
     ConsoleUI::printInfo("Visualization of the BlockChain:\n");
 
     std::string topBorder;
@@ -494,7 +878,7 @@ void Blockchain::drawChain() const
     for (size_t i = 0; i < chain.size(); i++)
     {
         std::stringstream ss;
-        ss << "Block " << chain[i].getIndex();
+        ss << "Block " << chain[i]->getIndex();
         std::string blockStr = ss.str();
         int padding = (11 - static_cast<int>(blockStr.size())) / 2;
 
@@ -9,19 +9,165 @@
 #include <iostream>
 #include <fstream>
 
-BlockchainController::BlockchainController(const std::map<std::string, std::string> &pubKeys)
-    : publicKeys(pubKeys) {}
+BlockchainController::BlockchainController(const PublicKeyCache &pubKeys,
+                                           const MiningScheduler::Config &miningConfig,
+                                           const Mempool::Config &mempoolConfig)
+    : blockchain(miningConfig), publicKeys(pubKeys),
+      mempool(mempoolConfig, [this](const Hash256 &txId)
+              { return blockchain.containsTransaction(txId); })
+{
+    sealer = std::thread(&BlockchainController::sealLoop, this);
+}
+
+BlockchainController::~BlockchainController()
+{
+    MiningJob job;
+    {
+        std::lock_guard<std::mutex> lock(miningMutex);
+        shuttingDown = true;
+        miningJob.cancel();
+        job = miningJob;
+    }
+    mempool.close();
+    miningIdle.notify_all();
+    sealer.join();
+    job.wait();
+}
+
+// Проверяет подпись транзакции и помещает ее в пул
+bool BlockchainController::submitTransaction(Transaction tx)
+{
+    // Дубликат и повтор отсекаются до дорогой проверки подписи; окончательно - атомарно в submit()
+    if (mempool.contains(tx.getTxId()) || blockchain.containsTransaction(tx.getTxId()))
+    {
+        ConsoleUI::printError("Duplicate transaction: " + tx.getTxId().toHex());
+        return false;
+    }
+
+    // Подпись проверяется в потоке отправителя и попадает в кеш: шаблон блока ее не перепроверяет
+    std::string error;
+    if (!blockchain.admitTransaction(tx, publicKeys.findEntry(tx.getSender()), error) ||
+        !mempool.submit(std::move(tx), error))
+    {
+        ConsoleUI::printError(error);
+        return false;
+    }
+    return true;
+}
+
+void BlockchainController::waitForPendingBlocks()
+{
+    mempool.flush();
+    std::unique_lock<std::mutex> lock(miningMutex);
+    miningIdle.wait(lock, [this]()
+                    { return shuttingDown || (mempool.isSettled() && !miningJob.isValid()); });
+}
+
+size_t BlockchainController::getPendingTransactionCount() const
+{
+    return mempool.size();
+}
+
+void BlockchainController::sealLoop()
+{
+    while (mempool.waitUntilSealable())
+    {
+        // Следующий блок строится от вершины, в которую уже добавлен предыдущий
+        std::unique_lock<std::mutex> lock(miningMutex);
+        miningIdle.wait(lock, [this]()
+                        { return shuttingDown || !miningJob.isValid(); });
+        if (shuttingDown)
+            return;
+
+        std::vector<Transaction> batch = mempool.takeTemplate([this](const std::string &address)
+                                                              { return blockchain.getBalance(address); });
+        if (batch.empty())
+        {
+            mempool.completeTemplate();
+            miningIdle.notify_all();
+            continue;
+        }
 
-// Обрабатывает список транзакций: подписывает их и добавляет в новый блок
-void BlockchainController::processTransactions(std::vector<Transaction> transactions)
+        ConsoleUI::printMining("Sealing block template with " + std::to_string(batch.size()) + " transactions");
+        std::vector<size_t> rejected;
+        std::shared_ptr<Block> block = blockchain.createBlockTemplate(batch, publicKeys, &rejected);
+        while (!block && !rejected.empty())
+        {
+            // Из пула удаляются только отклоненные транзакции; остальные запечатываются заново
+            std::vector<Hash256> evicted;
+            for (const size_t index : rejected)
+            {
+                evicted.push_back(batch[index].getTxId());
+            }
+            for (auto it = rejected.rbegin(); it != rejected.rend(); ++it)
+            {
+                batch.erase(batch.begin() + static_cast<std::ptrdiff_t>(*it));
+            }
+            mempool.evict(evicted);
+            ConsoleUI::printWarning(std::to_string(evicted.size()) + " transactions evicted from the block template, " +
+                                    std::to_string(batch.size()) + " left");
+
+            rejected.clear();
+            if (batch.empty())
+                break;
+            block = blockchain.createBlockTemplate(batch, publicKeys, &rejected);
+        }
+        if (!block)
+        {
+            if (!batch.empty())
+                ConsoleUI::printError("Block template rejected, " + std::to_string(batch.size()) + " transactions dropped");
+            mempool.completeTemplate();
+            miningIdle.notify_all();
+            continue;
+        }
+        startMiningLocked(std::move(block), std::move(batch));
+    }
+}
+
+void BlockchainController::startMiningLocked(std::shared_ptr<Block> block, std::vector<Transaction> batch)
 {
-    blockchain.addBlock(transactions, publicKeys);
+    miningTemplate = block;
+    miningBatch = std::move(batch);
+    miningJob = block->startMining(blockchain.getMiningScheduler(),
+                                   [this, block](bool cancelled)
+                                   { onMiningComplete(block, cancelled); });
+}
+
+void BlockchainController::onMiningComplete(const std::shared_ptr<Block> &block, bool cancelled)
+{
+    std::lock_guard<std::mutex> lock(miningMutex);
+
+    const bool failed = static_cast<bool>(miningJob.getError());
+    std::vector<Transaction> batch = std::move(miningBatch);
+    miningBatch.clear();
+    miningTemplate.reset();
+    miningJob = MiningJob();
+
+    if (failed)
+    {
+        ConsoleUI::printError("Mining failed, " + std::to_string(batch.size()) + " transactions dropped");
+        mempool.completeTemplate();
+    }
+    else if (cancelled || !block->isMined() || !blockchain.appendBlock(block))
+    {
+        // Вершина или реестр счетов изменились во время майнинга: транзакции не теряются,
+        // а повторно запечатываются от новой вершины (недействительные отсеет createBlockTemplate)
+        ConsoleUI::printWarning("Block #" + std::to_string(block->getIndex()) + " was not appended, " +
+                                std::to_string(batch.size()) + " transactions returned to the mempool");
+        mempool.returnTemplate(std::move(batch));
+    }
+    else
+    {
+        // txId добытых транзакций освобождаются; пул уже копит следующий блок
+        mempool.completeTemplate();
+    }
+    miningIdle.notify_all();
 }
 
 // Проверяет, валиден ли текущий блокчейн
-bool BlockchainController::isBlockchainValid() const
+bool BlockchainController::isBlockchainValid(bool fullVerification) const
 {
-    return blockchain.isChainValid(publicKeys);
+    return blockchain.isChainValid(publicKeys, fullVerification);
 }
 
 // Выводит блокчейн в консоль и отрисовывает его структуру
@@ -40,11 +186,20 @@ void BlockchainController::saveBlockchain(const std::string &filename, const std
 // Регистрирует нового пользователя в блокчейне
 void BlockchainController::registerUser(const std::string &username)
 {
+    std::lock_guard<std::mutex> lock(miningMutex);
     blockchain.addUser(username);
+
+    // Новый счет сдвигает временные id счетов шаблона: его решение будет отклонено appendBlock()
+    if (miningTemplate && blockchain.isTemplateStale(*miningTemplate))
+    {
+        ConsoleUI::printMining("Account registry changed, restarting block #" +
+                               std::to_string(miningTemplate->getIndex()));
+        miningJob.cancelStale();
+    }
 }
 
 // Возвращает баланс пользователя по его имени
-double BlockchainController::getUserBalance(const std::string &username) const
+Amount BlockchainController::getUserBalance(const std::string &username) const
 {
     return blockchain.getBalance(username);
 }
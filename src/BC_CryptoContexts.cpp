@@ -0,0 +1,133 @@
+// BC_CryptoContexts.cpp
+#include "BC_CryptoContexts.h"
+
+// Системные библиотеки (только для реализации)
+#include <memory>
+
+// OpenSSL компоненты
+#include <openssl/opensslv.h>
+
+namespace
+{
+    struct DigestContextDeleter
+    {
+        void operator()(EVP_MD_CTX *ctx) const { EVP_MD_CTX_free(ctx); }
+    };
+
+    struct CipherContextDeleter
+    {
+        void operator()(EVP_CIPHER_CTX *ctx) const { EVP_CIPHER_CTX_free(ctx); }
+    };
+
+    /// @brief Контекст потока и признак того, что он сейчас выдан
+    template <typename Context, typename Deleter>
+    struct ThreadSlot
+    {
+        std::unique_ptr<Context, Deleter> context;
+        bool leased = false;
+    };
+
+    thread_local ThreadSlot<EVP_MD_CTX, DigestContextDeleter> digestSlot;
+    thread_local ThreadSlot<EVP_CIPHER_CTX, CipherContextDeleter> cipherSlot;
+
+#if OPENSSL_VERSION_MAJOR >= 3
+    struct DigestDeleter
+    {
+        void operator()(EVP_MD *md) const { EVP_MD_free(md); }
+    };
+
+    struct CipherDeleter
+    {
+        void operator()(EVP_CIPHER *cipher) const { EVP_CIPHER_free(cipher); }
+    };
+#endif
+}
+
+// Реализация DigestLease
+CryptoContexts::DigestLease::DigestLease()
+    : context(nullptr), owned(false)
+{
+    if (digestSlot.leased)
+    {
+        context = EVP_MD_CTX_new();
+        owned = true;
+        return;
+    }
+
+    if (!digestSlot.context)
+        digestSlot.context.reset(EVP_MD_CTX_new());
+
+    context = digestSlot.context.get();
+    digestSlot.leased = (context != nullptr);
+}
+
+CryptoContexts::DigestLease::~DigestLease()
+{
+    if (!context)
+        return;
+
+    if (owned)
+    {
+        EVP_MD_CTX_free(context);
+        return;
+    }
+
+    // Сброс освобождает контекст ключа, но сохраняет выделенную структуру для следующей операции
+    EVP_MD_CTX_reset(context);
+    digestSlot.leased = false;
+}
+
+// Реализация CipherLease
+CryptoContexts::CipherLease::CipherLease()
+    : context(nullptr), owned(false)
+{
+    if (cipherSlot.leased)
+    {
+        context = EVP_CIPHER_CTX_new();
+        owned = true;
+        return;
+    }
+
+    if (!cipherSlot.context)
+        cipherSlot.context.reset(EVP_CIPHER_CTX_new());
+
+    context = cipherSlot.context.get();
+    cipherSlot.leased = (context != nullptr);
+}
+
+CryptoContexts::CipherLease::~CipherLease()
+{
+    if (!context)
+        return;
+
+    if (owned)
+    {
+        EVP_CIPHER_CTX_free(context);
+        return;
+    }
+
+    // Сброс стирает ключ и IV, структура остается для следующей операции
+    EVP_CIPHER_CTX_reset(context);
+    cipherSlot.leased = false;
+}
+
+// Алгоритмы извлекаются явно один раз, без неявного поиска провайдера в каждом Init
+const EVP_MD *CryptoContexts::sha256()
+{
+#if OPENSSL_VERSION_MAJOR >= 3
+    static const std::unique_ptr<EVP_MD, DigestDeleter> md(EVP_MD_fetch(nullptr, "SHA256", nullptr));
+    if (md)
+        return md.get();
+#endif
+    return EVP_sha256();
+}
+
+const EVP_CIPHER *CryptoContexts::aes256Cbc()
+{
+#if OPENSSL_VERSION_MAJOR >= 3
+    static const std::unique_ptr<EVP_CIPHER, CipherDeleter> cipher(EVP_CIPHER_fetch(nullptr, "AES-256-CBC", nullptr));
+    if (cipher)
+        return cipher.get();
+#endif
+    return EVP_aes_256_cbc();
+}
@@ -1,11 +1,11 @@
 // BC_CryptoUtils.cpp
 #include "BC_CryptoUtils.h"
 #include "BC_Utilities.h"
+#include "BC_SignatureScheme.h"
 
 // Системные библиотеки (только для реализации)
 #include <vector>
-#include <iomanip>
-#include <sstream>
+#include <cstdint>
 
 // OpenSSL компоненты
 #include <openssl/sha.h>
@@ -13,13 +13,46 @@
 #include <openssl/rand.h>
 #include <openssl/pem.h>
 #include <openssl/err.h>
+#include <openssl/x509.h>
 
 // Константы преобразования
 const size_t HEX_BYTE_WIDTH = 2;                        // Ширина hex-представления байта
 const size_t SHA256_HASH_LENGTH = SHA256_DIGEST_LENGTH; // Размер хеша SHA-256
 
-// Контекст RSA подписи
-const int RSA_PADDING_MODE = RSA_PKCS1_PADDING;
+// Таблица кодирования: два символа на каждое значение байта
+constexpr std::array<char, 256 * HEX_BYTE_WIDTH> makeHexEncodeTable()
+{
+    constexpr char digits[] = "0123456789abcdef";
+    std::array<char, 256 * HEX_BYTE_WIDTH> table{};
+    for (size_t i = 0; i < 256; ++i)
+    {
+        table[i * HEX_BYTE_WIDTH] = digits[i >> 4];
+        table[i * HEX_BYTE_WIDTH + 1] = digits[i & 0x0F];
+    }
+    return table;
+}
+
+// Таблица декодирования: значение полубайта или HEX_INVALID
+const uint8_t HEX_INVALID = 0x80;
+constexpr std::array<uint8_t, 256> makeHexDecodeTable()
+{
+    std::array<uint8_t, 256> table{};
+    for (size_t i = 0; i < 256; ++i)
+    {
+        if (i >= '0' && i <= '9')
+            table[i] = static_cast<uint8_t>(i - '0');
+        else if (i >= 'a' && i <= 'f')
+            table[i] = static_cast<uint8_t>(i - 'a' + 10);
+        else if (i >= 'A' && i <= 'F')
+            table[i] = static_cast<uint8_t>(i - 'A' + 10);
+        else
+            table[i] = HEX_INVALID;
+    }
+    return table;
+}
+
+constexpr std::array<char, 256 * HEX_BYTE_WIDTH> HEX_ENCODE_TABLE = makeHexEncodeTable();
+constexpr std::array<uint8_t, 256> HEX_DECODE_TABLE = makeHexDecodeTable();
 
 // Реализация методов хеширования
 std::string CryptoUtils::calculateHash(const std::string &input)
@@ -31,162 +64,145 @@ std::string CryptoUtils::calculateHash(const std::string &input)
            input.size(),
            hash);
 
-    std::stringstream ss;
-    for (size_t i = 0; i < SHA256_HASH_LENGTH; ++i)
+    return toHex(hash, SHA256_HASH_LENGTH);
+}
+
+CryptoUtils::Digest CryptoUtils::calculateDigest(const std::string &input)
+{
+    Digest digest;
+    SHA256(reinterpret_cast<const unsigned char *>(input.data()),
+           input.size(),
+           digest.data());
+    return digest;
+}
+
+std::string CryptoUtils::toHex(const unsigned char *data, size_t length)
+{
+    std::string hex(length * HEX_BYTE_WIDTH, '\0');
+    char *out = hex.data();
+    for (size_t i = 0; i < length; ++i)
     {
-        ss << std::hex << std::setw(2) << std::setfill('0')
-           << static_cast<int>(hash[i]);
+        const char *pair = HEX_ENCODE_TABLE.data() + data[i] * HEX_BYTE_WIDTH;
+        out[i * HEX_BYTE_WIDTH] = pair[0];
+        out[i * HEX_BYTE_WIDTH + 1] = pair[1];
     }
+    return hex;
+}
+
+bool CryptoUtils::fromHex(std::string_view hex, unsigned char *out, size_t length)
+{
+    if (hex.size() != length * HEX_BYTE_WIDTH)
+        return false;
 
-    return ss.str();
+    // Недопустимые символы отмечены старшим битом; проверка одна на весь буфер
+    uint8_t invalid = 0;
+    for (size_t i = 0; i < length; ++i)
+    {
+        const uint8_t high = HEX_DECODE_TABLE[static_cast<unsigned char>(hex[i * HEX_BYTE_WIDTH])];
+        const uint8_t low = HEX_DECODE_TABLE[static_cast<unsigned char>(hex[i * HEX_BYTE_WIDTH + 1])];
+        invalid |= high | low;
+        out[i] = static_cast<unsigned char>((high << 4) | (low & 0x0F));
+    }
+    return (invalid & HEX_INVALID) == 0;
 }
 
-// Реализация методов цифровой подписи
-std::string CryptoUtils::signData(const std::string &data, const std::string &privateKeyPEM)
+bool CryptoUtils::fromHex(std::string_view hex, Signature &out)
 {
-    BIO *bio = nullptr;
-    EVP_PKEY *pkey = nullptr;
-    EVP_MD_CTX *ctx = nullptr;
-    std::string result;
+    if (hex.size() % HEX_BYTE_WIDTH != 0)
+        return false;
 
-    try
+    out.resize(hex.size() / HEX_BYTE_WIDTH);
+    if (!fromHex(hex, out.data(), out.size()))
     {
-        // Этап 1: Загрузка приватного ключа из PEM-строки
-        bio = BIO_new_mem_buf(privateKeyPEM.data(), -1);
-        if (!bio)
-            throw std::runtime_error("BIO_new_mem_buf failed");
-
-        pkey = PEM_read_bio_PrivateKey(bio, nullptr, nullptr, nullptr);
-        if (!pkey)
-            throw std::runtime_error("PEM_read_bio_PrivateKey failed");
-
-        BIO_free(bio);
-        bio = nullptr;
-
-        // Этап 2: Создание контекста подписи
-        ctx = EVP_MD_CTX_new();
-        if (!ctx)
-            throw std::runtime_error("EVP_MD_CTX_new failed");
-
-        // Инициализация алгоритма подписи
-        if (1 != EVP_DigestSignInit(ctx, nullptr, EVP_sha256(), nullptr, pkey))
-        {
-            throw std::runtime_error("EVP_DigestSignInit failed");
-        }
-
-        // Этап 3: Вычисление подписи
-        if (1 != EVP_DigestSignUpdate(ctx, data.data(), data.size()))
-        {
-            throw std::runtime_error("EVP_DigestSignUpdate failed");
-        }
-
-        // Определение размера подписи
-        size_t sigLen = 0;
-        if (1 != EVP_DigestSignFinal(ctx, nullptr, &sigLen))
-        {
-            throw std::runtime_error("EVP_DigestSignFinal (length) failed");
-        }
-
-        // Генерация окончательной подписи
-        std::vector<unsigned char> sig(sigLen);
-        if (1 != EVP_DigestSignFinal(ctx, sig.data(), &sigLen))
-        {
-            throw std::runtime_error("EVP_DigestSignFinal failed");
-        }
-
-        // Конвертация в HEX
-        std::stringstream ss;
-        for (size_t i = 0; i < sigLen; ++i)
-        {
-            ss << std::hex << std::setw(2) << std::setfill('0')
-               << static_cast<int>(sig[i]);
-        }
-        result = ss.str();
+        out.clear();
+        return false;
     }
-    catch (const std::exception &e)
+    return true;
+}
+
+// Реализация методов цифровой подписи
+CryptoUtils::Signature CryptoUtils::signData(std::string_view data, const std::string &privateKeyPEM)
+{
+    // Загрузка приватного ключа из PEM-строки
+    BIO *bio = BIO_new_mem_buf(privateKeyPEM.data(), static_cast<int>(privateKeyPEM.size()));
+    if (!bio)
+    {
+        ConsoleUI::printError("BIO_new_mem_buf failed");
+        return Signature();
+    }
+
+    EVP_PKEY *pkey = PEM_read_bio_PrivateKey(bio, nullptr, nullptr, nullptr);
+    BIO_free(bio);
+
+    if (!pkey)
     {
         char openssl_error[256] = {0};
         ERR_error_string_n(ERR_get_error(), openssl_error, sizeof(openssl_error));
-        ConsoleUI::printError(std::string(e.what()) + ": " + openssl_error);
-        result.clear();
+        ConsoleUI::printError(std::string("PEM_read_bio_PrivateKey failed: ") + openssl_error);
+        return Signature();
     }
 
-    // Очистка ресурсов
-    if (bio)
-        BIO_free(bio);
-    if (pkey)
-        EVP_PKEY_free(pkey);
-    if (ctx)
-        EVP_MD_CTX_free(ctx);
+    // Схема подписи определяется типом ключа
+    Signature result;
+    const SignatureScheme *scheme = SignatureScheme::forKey(pkey);
+    if (scheme)
+    {
+        result = scheme->sign(pkey, data);
+    }
+    else
+    {
+        ConsoleUI::printError("Unsupported private key type");
+    }
 
+    EVP_PKEY_free(pkey);
     return result;
 }
 
-// Реализация верификации подписи
-bool CryptoUtils::verifySignature(const std::string &data, const std::string &signatureHex, const std::string &publicKeyPEM)
-{   
-    // Этап 1: Конвертация HEX-подписи в бинарный формат
-    std::vector<unsigned char> signature;
-    for (size_t i = 0; i < signatureHex.length(); i += HEX_BYTE_WIDTH)
-    {
-        std::string byteString = signatureHex.substr(i, HEX_BYTE_WIDTH);
-        unsigned char byte = static_cast<unsigned char>(std::stoi(byteString, nullptr, 16));
-        signature.push_back(byte);
-    }
-
-    // Этап 2: Загрузка публичного ключа
-    BIO *bio = BIO_new_mem_buf(publicKeyPEM.data(), -1);
+// Загрузка публичного ключа из PEM
+std::shared_ptr<EVP_PKEY> CryptoUtils::loadPublicKey(const std::string &publicKeyPEM)
+{
+    BIO *bio = BIO_new_mem_buf(publicKeyPEM.data(), static_cast<int>(publicKeyPEM.size()));
     if (!bio)
     {
         ConsoleUI::printError("BIO_new_mem_buf failed");
-        return false;
+        return nullptr;
     }
 
     EVP_PKEY *pkey = PEM_read_bio_PUBKEY(bio, nullptr, nullptr, nullptr);
     BIO_free(bio);
 
-    if (!pkey) {
+    if (!pkey)
+    {
         ConsoleUI::printError("PEM_read_bio_PUBKEY failed");
-        return false;
+        return nullptr;
     }
+    return std::shared_ptr<EVP_PKEY>(pkey, EVP_PKEY_free);
+}
 
-    // Этап 3: Верификация подписи
-    EVP_MD_CTX *ctx = EVP_MD_CTX_new();
-    if (!ctx)
+// Отпечаток публичного ключа
+CryptoUtils::Digest CryptoUtils::publicKeyFingerprint(EVP_PKEY *publicKey)
+{
+    Digest fingerprint{};
+    unsigned char *der = nullptr;
+    const int derLength = publicKey ? i2d_PUBKEY(publicKey, &der) : -1;
+    if (derLength > 0)
     {
-        EVP_PKEY_free(pkey);
-        ConsoleUI::printError("EVP_MD_CTX_new failed");
-        return false;
-    }
-
-    // Настройка алгоритма проверки
-    if (EVP_DigestVerifyInit(ctx, nullptr, EVP_sha256(), nullptr, pkey) <= 0)
-    {
-        EVP_MD_CTX_free(ctx);
-        EVP_PKEY_free(pkey);
-        return false;
+        SHA256(der, static_cast<size_t>(derLength), fingerprint.data());
     }
+    OPENSSL_free(der);
+    return fingerprint;
+}
 
-    // Настройка алгоритма проверки
-    bool verificationResult = false;
-    do {
-        if (EVP_DigestVerifyInit(ctx, nullptr, EVP_sha256(), nullptr, pkey) <= 0) break;
-        
-        // Установка режима паддинга для RSA
-        EVP_PKEY_CTX *pctx = EVP_MD_CTX_pkey_ctx(ctx);
-        if (pctx) {
-            EVP_PKEY_CTX_set_rsa_padding(pctx, RSA_PADDING_MODE);
-        }
-
-        if (EVP_DigestVerifyUpdate(ctx, data.data(), data.size()) <= 0) break;
-        
-        verificationResult = (1 == EVP_DigestVerifyFinal(ctx, 
-            signature.data(), 
-            signature.size()));
-    } while (false);
-    
-    EVP_MD_CTX_free(ctx);
-    EVP_PKEY_free(pkey);
+// Реализация верификации подписи
+bool CryptoUtils::verifySignature(std::string_view data, SignatureView signature, const std::string &publicKeyPEM)
+{
+    const std::shared_ptr<EVP_PKEY> pkey = loadPublicKey(publicKeyPEM);
+    return pkey && verifySignature(data, signature, pkey.get());
+}
 
-    return verificationResult;
+bool CryptoUtils::verifySignature(std::string_view data, SignatureView signature, EVP_PKEY *publicKey)
+{
+    // Схема подписи определяется типом ключа
+    const SignatureScheme *scheme = SignatureScheme::forKey(publicKey);
+    return scheme && scheme->verify(publicKey, data, signature);
 }
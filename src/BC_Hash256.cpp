@@ -0,0 +1,26 @@
+// BC_Hash256.cpp
+#include "BC_Hash256.h"
+#include "BC_CryptoUtils.h"
+
+// Системные библиотеки (только для реализации)
+#include <stdexcept>
+
+Hash256 Hash256::fromHex(std::string_view hex)
+{
+    Hash256 result;
+    if (!CryptoUtils::fromHex(hex, result.bytes.data(), SIZE))
+    {
+        throw std::invalid_argument("Invalid hash hex: " + std::string(hex));
+    }
+    return result;
+}
+
+std::string Hash256::toHex() const
+{
+    return CryptoUtils::toHex(bytes.data(), SIZE);
+}
+
+std::ostream &operator<<(std::ostream &os, const Hash256 &hash)
+{
+    return os << hash.toHex();
+}
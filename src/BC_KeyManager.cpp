@@ -14,7 +14,8 @@
 
 namespace fs = std::filesystem;
 
-KeyManager::KeyManager(const std::vector<std::string> &users)
+KeyManager::KeyManager(const std::vector<std::string> &users, SignatureScheme::Algorithm algorithm)
+    : scheme(SignatureScheme::get(algorithm))
 {
     for (const auto &user : users)
     {
@@ -22,24 +23,25 @@ KeyManager::KeyManager(const std::vector<std::string> &users)
     }
 }
 
-// Генерация пары RSA-ключей
+// Генерация пары ключей выбранной схемы
 void KeyManager::generateAndSaveKeys(const std::string &username)
 {
-    EVP_PKEY *keyPair = RSAKeyGenerator::generateRSAKeyPair();
+    EVP_PKEY *keyPair = scheme.generateKeyPair();
     if (!keyPair)
     {
         ConsoleUI::printError("Failed to generate key for " + username);
         return;
     }
 
-    ConsoleUI::printSuccess("Private key generate success for " + username);
+    ConsoleUI::printSuccess("Private key generate success for " + username + " (" + scheme.name() + ")");
     
     // Получение PEM-представления ключей
     std::string publicKeyPEM = RSAKeyGenerator::getPEMFromPublicKey(keyPair);
     std::string privateKeyPEM = RSAKeyGenerator::getPEMFromPrivateKey(keyPair);
 
-    // Сохраняем публичный ключ
+    // Сохраняем публичный ключ и сразу разбираем его для проверок подписей
     publicKeys[username] = publicKeyPEM;
+    keyCache.setKey(username, publicKeyPEM);
 
     // Создание папки keys, если она не существует
     fs::path keysDir = PROJECT_ROOT "/keys";
@@ -85,7 +87,7 @@ void KeyManager::generateAndSaveKeys(const std::string &username)
 // Добавляет ключи для нового пользователя
 void KeyManager::addUserKeys(const std::string &username)
 {
-    if (publicKeys.count(username) > 0)
+    if (publicKeys.contains(username))
     {
         throw std::runtime_error("User already exists");
     }
@@ -93,11 +95,17 @@ void KeyManager::addUserKeys(const std::string &username)
 }
 
 // Возвращает карту публичных ключей
-std::map<std::string, std::string> &KeyManager::getPublicKeys()
+const FlatStringMap<std::string> &KeyManager::getPublicKeys() const
 {
     return publicKeys;
 }
 
+// Возвращает кеш разобранных публичных ключей
+const PublicKeyCache &KeyManager::getPublicKeyCache() const
+{
+    return keyCache;
+}
+
 // Укорачивает строку ключа
 std::string KeyManager::truncateKey(const std::string &key, int headLen, int tailLen)
 {
@@ -0,0 +1,50 @@
+// BC_LedgerOverlay.cpp
+#include "BC_LedgerOverlay.h"
+
+// Системные библиотеки (только для реализации)
+#include <algorithm>
+
+std::vector<std::pair<AccountId, Amount>> LedgerOverlay::changes() const
+{
+    std::vector<std::pair<AccountId, Amount>> sorted(writes.begin(), writes.end());
+    std::sort(sorted.begin(), sorted.end());
+    return sorted;
+}
+
+std::vector<std::pair<AccountId, Amount>> LedgerOverlay::deltas() const
+{
+    // Балансы неотрицательны, поэтому разность нового и базового значения не переполняется
+    std::vector<std::pair<AccountId, Amount>> sorted = changes();
+    for (auto &[id, balance] : sorted)
+    {
+        balance -= id < base->size() ? (*base)[id] : 0;
+    }
+    return sorted;
+}
+
+std::pair<AccountId, bool> LedgerOverlay::provisionalAccount(std::string_view address)
+{
+    const auto [id, inserted] = newIds.tryEmplace(address);
+    if (inserted)
+    {
+        *id = firstNewId + static_cast<AccountId>(newAddresses.size());
+        newAddresses.emplace_back(address);
+    }
+    return {*id, inserted};
+}
+
+AccountId LedgerOverlay::findProvisional(std::string_view address) const
+{
+    const AccountId *id = newIds.find(address);
+    return id ? *id : AccountRegistry::NO_ACCOUNT;
+}
+
+void LedgerOverlay::commit(std::vector<Amount> &ledger) const
+{
+    for (const auto &[id, balance] : writes)
+    {
+        if (id >= ledger.size())
+            ledger.resize(static_cast<size_t>(id) + 1, 0);
+        ledger[id] = balance;
+    }
+}
@@ -0,0 +1,293 @@
+// BC_Mempool.cpp
+#include "BC_Mempool.h"
+#include "BC_Utilities.h"
+
+// Системные библиотеки (только для реализации)
+#include <algorithm>
+#include <utility>
+
+Mempool::Mempool(const Config &config, CommittedLookup isCommitted)
+    : config(config), isCommitted(std::move(isCommitted))
+{
+    this->config.maxBlockTransactions = std::max<size_t>(1, config.maxBlockTransactions);
+}
+
+bool Mempool::submit(Transaction tx, std::string &error)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (closed)
+        {
+            error = "Mempool is closed";
+            return false;
+        }
+        if (queued >= config.capacity)
+        {
+            error = "Mempool is full (" + std::to_string(config.capacity) + " transactions)";
+            return false;
+        }
+        if (known.count(tx.getTxId()) != 0)
+        {
+            error = "Duplicate transaction: " + tx.getTxId().toHex();
+            return false;
+        }
+        if (isCommitted && isCommitted(tx.getTxId()))
+        {
+            error = "Transaction already in blockchain: " + tx.getTxId().toHex();
+            return false;
+        }
+        known.insert(tx.getTxId());
+
+        const std::string sender = tx.getSender();
+        senders[sender].push_back(Entry{std::move(tx), Clock::now()});
+        ++queued;
+        stalled = false;
+    }
+    changed.notify_all();
+    return true;
+}
+
+bool Mempool::contains(const Hash256 &txId) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return known.count(txId) != 0;
+}
+
+Mempool::Clock::time_point Mempool::oldestArrivalLocked() const
+{
+    Clock::time_point oldest = Clock::time_point::max();
+    for (const auto &[sender, queue] : senders)
+    {
+        if (!queue.empty())
+            oldest = std::min(oldest, queue.front().arrival);
+    }
+    return oldest;
+}
+
+bool Mempool::waitUntilSealable()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!closed)
+    {
+        if (queued == 0)
+        {
+            // Запрос относится только к уже принятым транзакциям
+            sealRequested = false;
+            changed.wait(lock);
+            continue;
+        }
+
+        // Неоплачиваемые транзакции ждут зачислений; по истечении срока takeTemplate() их удалит
+        Clock::time_point deadline = oldestArrivalLocked();
+        if (stalled)
+        {
+            deadline += std::chrono::milliseconds(config.maxPendingMs);
+        }
+        else
+        {
+            if (queued >= config.maxBlockTransactions || sealRequested)
+                return true;
+            deadline += std::chrono::milliseconds(config.maxBlockDelayMs);
+        }
+
+        if (Clock::now() >= deadline)
+            return true;
+        changed.wait_until(lock, deadline);
+    }
+    return false;
+}
+
+std::vector<Transaction> Mempool::takeTemplate(const BalanceLookup &balanceOf)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Балансы с учетом уже выбранных транзакций; подтвержденный баланс запрашивается один раз
+    std::unordered_map<std::string, Amount> projected;
+    auto balance = [&](const std::string &address) -> Amount &
+    {
+        auto [it, inserted] = projected.try_emplace(address, 0);
+        if (inserted)
+            it->second = balanceOf(address);
+        return it->second;
+    };
+
+    // Голова очереди отправителя; куча упорядочена по времени создания головы
+    struct Head
+    {
+        Timestamp timestamp;
+        std::deque<Entry> *queue;
+    };
+    auto later = [](const Head &a, const Head &b)
+    { return a.timestamp > b.timestamp; };
+
+    std::vector<Transaction> batch;
+    batch.reserve(std::min(config.maxBlockTransactions, queued));
+    const Clock::time_point expiry = Clock::now() - std::chrono::milliseconds(config.maxPendingMs);
+
+    while (batch.size() < config.maxBlockTransactions && queued > 0)
+    {
+        // Проход слиянием: отправитель без средств на голову очереди пропускается до следующего прохода
+        std::vector<Head> heads;
+        for (auto &[sender, queue] : senders)
+        {
+            if (!queue.empty())
+                heads.push_back(Head{queue.front().tx.getTimestamp(), &queue});
+        }
+        std::make_heap(heads.begin(), heads.end(), later);
+
+        const size_t before = batch.size();
+        while (!heads.empty() && batch.size() < config.maxBlockTransactions)
+        {
+            std::pop_heap(heads.begin(), heads.end(), later);
+            std::deque<Entry> &queue = *heads.back().queue;
+            heads.pop_back();
+
+            const Transaction &tx = queue.front().tx;
+            Amount &senderBalance = balance(tx.getSender());
+            if (tx.getAmount() > senderBalance)
+                continue;
+
+            senderBalance -= tx.getAmount();
+            Amount &receiverBalance = balance(tx.getReceiver());
+            Amount credited = 0;
+            if (!AmountUtils::add(receiverBalance, tx.getAmount(), credited))
+            {
+                senderBalance += tx.getAmount();
+                continue;
+            }
+            receiverBalance = credited;
+
+            batch.push_back(std::move(queue.front().tx));
+            queue.pop_front();
+            --queued;
+
+            if (!queue.empty())
+            {
+                heads.push_back(Head{queue.front().tx.getTimestamp(), &queue});
+                std::push_heap(heads.begin(), heads.end(), later);
+            }
+        }
+
+        if (batch.size() > before)
+            continue;
+
+        // Ни одна голова не оплачивается: очереди ждут зачислений из следующих блоков,
+        // а удаляются только головы, ожидающие дольше maxPendingMs
+        size_t expired = 0;
+        for (auto &[sender, queue] : senders)
+        {
+            if (queue.empty() || queue.front().arrival > expiry)
+                continue;
+            const Transaction &tx = queue.front().tx;
+            ConsoleUI::printWarning("Dropping unaffordable transaction " + tx.getTxId().toHex().substr(0, 12) +
+                                    "... from " + sender + " (" + AmountUtils::format(tx.getAmount()) +
+                                    "): pending for more than " + std::to_string(config.maxPendingMs) + " ms");
+            known.erase(tx.getTxId());
+            queue.pop_front();
+            --queued;
+            ++expired;
+        }
+        if (expired == 0)
+            break;
+    }
+
+    std::erase_if(senders, [](const auto &item)
+                  { return item.second.empty(); });
+    if (queued == 0)
+        sealRequested = false;
+    stalled = batch.empty() && queued > 0;
+
+    inFlight.reserve(inFlight.size() + batch.size());
+    for (const Transaction &tx : batch)
+    {
+        inFlight.push_back(tx.getTxId());
+    }
+    return batch;
+}
+
+void Mempool::completeTemplate()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        // Добавленный блок мог зачислить средства отправителям отложенных транзакций
+        if (!inFlight.empty())
+            stalled = false;
+        for (const Hash256 &txId : inFlight)
+        {
+            known.erase(txId);
+        }
+        inFlight.clear();
+    }
+    changed.notify_all();
+}
+
+void Mempool::returnTemplate(std::vector<Transaction> batch)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::unordered_set<Hash256> returned;
+        returned.reserve(batch.size());
+
+        // Срок ожидания уже истек: шаблон от новой вершины строится сразу
+        const Clock::time_point arrival = Clock::now() - std::chrono::milliseconds(config.maxBlockDelayMs);
+        for (auto it = batch.rbegin(); it != batch.rend(); ++it)
+        {
+            returned.insert(it->getTxId());
+            const std::string sender = it->getSender();
+            senders[sender].push_front(Entry{std::move(*it), arrival});
+            ++queued;
+        }
+        std::erase_if(inFlight, [&](const Hash256 &txId)
+                      { return returned.count(txId) != 0; });
+        stalled = false;
+    }
+    changed.notify_all();
+}
+
+void Mempool::evict(const std::vector<Hash256> &txIds)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const Hash256 &txId : txIds)
+    {
+        std::erase(inFlight, txId);
+        known.erase(txId);
+    }
+}
+
+void Mempool::flush()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        // Пустой пул нечего запечатывать: следующая транзакция ждет обычных лимитов
+        if (queued == 0)
+            return;
+        sealRequested = true;
+    }
+    changed.notify_all();
+}
+
+void Mempool::close()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+    }
+    changed.notify_all();
+}
+
+size_t Mempool::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return queued + inFlight.size();
+}
+
+bool Mempool::isSettled() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return inFlight.empty() && (queued == 0 || stalled);
+}
+
+const Mempool::Config &Mempool::getConfig() const
+{
+    return config;
+}
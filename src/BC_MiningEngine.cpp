@@ -0,0 +1,40 @@
+// BC_MiningEngine.cpp
+#include "BC_MiningEngine.h"
+#include "BC_CryptoUtils.h"
+
+MiningEngine::MiningEngine(const std::string &headerPrefix, Sha256Lanes::Backend lanesBackend)
+    : midstate(Sha256Lanes::prepare(headerPrefix)), // Префикс хешируется один раз
+      backend(lanesBackend)
+{
+}
+
+std::string MiningEngine::hashWithNonce(uint64_t nonce) const
+{
+    unsigned char digest[Sha256Lanes::DIGEST_SIZE];
+    Sha256Lanes::hashNonce(midstate, nonce, digest);
+    return CryptoUtils::toHex(digest, sizeof(digest));
+}
+
+size_t MiningEngine::batchSize() const
+{
+    return Sha256Lanes::lanesOf(backend);
+}
+
+Sha256Lanes::Backend MiningEngine::getBackend() const
+{
+    return backend;
+}
+
+void MiningEngine::hashBatch(uint64_t firstNonce, unsigned char *digests) const
+{
+    Sha256Lanes::hashNonces(backend, midstate, firstNonce, digests);
+}
+
+void MiningEngine::appendNonce(std::string &out, uint64_t nonce)
+{
+    // Кодирование nonce в 8 байт little-endian
+    for (size_t i = 0; i < NONCE_SIZE; ++i)
+    {
+        out.push_back(static_cast<char>((nonce >> (8 * i)) & 0xff));
+    }
+}
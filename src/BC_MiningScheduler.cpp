@@ -0,0 +1,332 @@
+// BC_MiningScheduler.cpp
+#include "BC_MiningScheduler.h"
+#include "BC_Utilities.h"
+
+// Системные библиотеки (только для реализации)
+#include <algorithm>
+#include <string>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+/// @brief Общее состояние задания майнинга
+struct MiningJobState
+{
+    MiningScheduler::Task task;                 ///< Функция задания
+    MiningScheduler::Completion onComplete;     ///< Обработчик завершения
+    std::atomic<bool> cancelled{false};         ///< Флаг отмены
+    std::atomic<bool> stale{false};             ///< Отменено, потому что результат устарел
+
+    std::mutex doneMutex;                       ///< Защита флага завершения и ошибки
+    std::condition_variable doneCondition;      ///< Сигнал о завершении
+    bool done = false;                          ///< Задание завершено
+    std::exception_ptr error;                   ///< Первое исключение рабочего потока
+
+    /// @brief Запоминает первую ошибку и отменяет задание, чтобы остальные потоки прекратили перебор
+    void fail(std::exception_ptr exception)
+    {
+        {
+            std::lock_guard<std::mutex> lock(doneMutex);
+            if (!error)
+                error = std::move(exception);
+        }
+        cancelled.store(true, std::memory_order_release);
+    }
+
+    bool hasError()
+    {
+        std::lock_guard<std::mutex> lock(doneMutex);
+        return static_cast<bool>(error);
+    }
+
+    /// @brief Вызывает обработчик завершения; его исключения не выходят за пределы потока пула
+    void runCompletion()
+    {
+        if (!onComplete)
+            return;
+        try
+        {
+            onComplete(cancelled.load(std::memory_order_acquire));
+        }
+        catch (const std::exception &e)
+        {
+            ConsoleUI::printError(std::string("Mining completion handler failed: ") + e.what());
+        }
+        catch (...)
+        {
+            ConsoleUI::printError("Mining completion handler failed: unknown exception");
+        }
+    }
+
+    void markDone()
+    {
+        {
+            std::lock_guard<std::mutex> lock(doneMutex);
+            done = true;
+        }
+        doneCondition.notify_all();
+    }
+};
+
+// Реализация методов MiningJob
+MiningJob::MiningJob(std::shared_ptr<MiningJobState> jobState)
+    : state(std::move(jobState)) {}
+
+void MiningJob::wait() const
+{
+    if (!state)
+        return;
+    std::unique_lock<std::mutex> lock(state->doneMutex);
+    state->doneCondition.wait(lock, [this]()
+                              { return state->done; });
+}
+
+bool MiningJob::waitFor(std::chrono::milliseconds timeout) const
+{
+    if (!state)
+        return true;
+    std::unique_lock<std::mutex> lock(state->doneMutex);
+    return state->doneCondition.wait_for(lock, timeout, [this]()
+                                         { return state->done; });
+}
+
+void MiningJob::cancel()
+{
+    if (state)
+        state->cancelled.store(true, std::memory_order_release);
+}
+
+void MiningJob::cancelStale()
+{
+    if (!state)
+        return;
+    state->stale.store(true, std::memory_order_release);
+    state->cancelled.store(true, std::memory_order_release);
+}
+
+bool MiningJob::isDone() const
+{
+    if (!state)
+        return true;
+    std::lock_guard<std::mutex> lock(state->doneMutex);
+    return state->done;
+}
+
+bool MiningJob::isCancelled() const
+{
+    return state && state->cancelled.load(std::memory_order_acquire);
+}
+
+std::exception_ptr MiningJob::getError() const
+{
+    if (!state)
+        return nullptr;
+    std::lock_guard<std::mutex> lock(state->doneMutex);
+    return state->error;
+}
+
+bool MiningJob::isValid() const
+{
+    return static_cast<bool>(state);
+}
+
+// Реализация методов MiningScheduler
+MiningScheduler::MiningScheduler(const Config &requested)
+    : config(requested)
+{
+    const unsigned int hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    if (config.reservedCores >= hardwareThreads)
+    {
+        ConsoleUI::printWarning("Cannot reserve " + std::to_string(config.reservedCores) + " of " +
+                                std::to_string(hardwareThreads) + " cores; keeping one core for mining");
+        config.reservedCores = hardwareThreads - 1;
+    }
+
+    if (config.workerCount == 0)
+    {
+        config.workerCount = hardwareThreads - config.reservedCores;
+    }
+
+    // Сэмплер опрашивает счетчики раз в секунду либо с периодом итоговой строки
+    const unsigned int sampleMs = config.statsIntervalMs ? config.statsIntervalMs : 1000;
+    telemetry = std::make_unique<MiningTelemetry>(config.workerCount, std::chrono::milliseconds(sampleMs),
+                                                  config.statsIntervalMs != 0);
+
+    workers.reserve(config.workerCount);
+    for (unsigned int i = 0; i < config.workerCount; ++i)
+    {
+        workers.emplace_back(&MiningScheduler::workerLoop, this, i);
+
+        if (config.pinThreads)
+        {
+            // Потоки майнинга занимают ядра после зарезервированных под валидацию
+            const unsigned int core = (config.reservedCores + i) % hardwareThreads;
+            if (!pinToCore(workers.back(), core))
+            {
+                ConsoleUI::printWarning("Failed to pin mining worker " + std::to_string(i) +
+                                        " to core " + std::to_string(core));
+            }
+        }
+    }
+
+    ConsoleUI::printMining("Mining pool started: " + std::to_string(config.workerCount) + " workers, " +
+                           std::to_string(config.reservedCores) + " reserved cores" +
+                           (config.pinThreads ? ", pinned" : ""));
+}
+
+MiningScheduler::~MiningScheduler()
+{
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        stopping = true;
+        for (auto &job : queue)
+        {
+            job->cancelled.store(true, std::memory_order_release);
+        }
+    }
+    jobReady.notify_all();
+
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+
+    // Незавершенные задания получают обработчик завершения как отмененные и не блокируют ожидающих
+    for (auto &job : queue)
+    {
+        job->runCompletion();
+        job->markDone();
+    }
+}
+
+MiningJob MiningScheduler::submit(Task task, Completion onComplete)
+{
+    auto job = std::make_shared<MiningJobState>();
+    job->task = std::move(task);
+    job->onComplete = std::move(onComplete);
+
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        if (stopping)
+        {
+            job->cancelled.store(true, std::memory_order_release);
+            job->markDone();
+            return MiningJob(job);
+        }
+
+        queue.push_back(job);
+        if (queue.size() == 1)
+        {
+            startNextJob();
+        }
+    }
+    return MiningJob(job);
+}
+
+void MiningScheduler::run(const Task &task)
+{
+    submit(task).wait();
+}
+
+unsigned int MiningScheduler::getWorkerCount() const
+{
+    return config.workerCount;
+}
+
+const MiningScheduler::Config &MiningScheduler::getConfig() const
+{
+    return config;
+}
+
+MiningTelemetry &MiningScheduler::getTelemetry()
+{
+    return *telemetry;
+}
+
+void MiningScheduler::startNextJob()
+{
+    pendingWorkers = config.workerCount;
+    ++generation;
+    jobReady.notify_all();
+}
+
+void MiningScheduler::workerLoop(unsigned int workerIndex)
+{
+    uint64_t seenGeneration = 0;
+
+    while (true)
+    {
+        std::shared_ptr<MiningJobState> job;
+        {
+            // Парковка до появления нового задания
+            std::unique_lock<std::mutex> lock(stateMutex);
+            jobReady.wait(lock, [&]()
+                          { return stopping || generation != seenGeneration; });
+            if (stopping)
+                return;
+
+            seenGeneration = generation;
+            job = queue.front();
+        }
+
+        try
+        {
+            job->task(workerIndex, config.workerCount, job->cancelled);
+        }
+        catch (const std::exception &e)
+        {
+            ConsoleUI::printError("Mining worker " + std::to_string(workerIndex) + " failed: " + e.what());
+            job->fail(std::current_exception());
+        }
+        catch (...)
+        {
+            ConsoleUI::printError("Mining worker " + std::to_string(workerIndex) + " failed: unknown exception");
+            job->fail(std::current_exception());
+        }
+
+        bool lastWorker = false;
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            lastWorker = (--pendingWorkers == 0);
+        }
+        if (!lastWorker)
+            continue;
+
+        // Последний поток завершает задание и запускает следующее из очереди
+        if (job->stale.load(std::memory_order_acquire) && !job->hasError())
+        {
+            telemetry->recordStaleJob();
+        }
+        job->runCompletion();
+        job->markDone();
+
+        std::lock_guard<std::mutex> lock(stateMutex);
+        queue.pop_front();
+        if (!queue.empty() && !stopping)
+        {
+            startNextJob();
+        }
+    }
+}
+
+bool MiningScheduler::pinToCore(std::thread &thread, unsigned int core)
+{
+#if defined(_WIN32)
+    const DWORD_PTR mask = static_cast<DWORD_PTR>(1) << (core % (sizeof(DWORD_PTR) * 8));
+    return SetThreadAffinityMask(static_cast<HANDLE>(thread.native_handle()), mask) != 0;
+#elif defined(__linux__)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(core, &cpuSet);
+    return pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cpuSet) == 0;
+#else
+    (void)thread;
+    (void)core;
+    return false;
+#endif
+}
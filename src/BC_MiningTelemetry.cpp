@@ -0,0 +1,107 @@
+// BC_MiningTelemetry.cpp
+#include "BC_MiningTelemetry.h"
+#include "BC_Utilities.h"
+
+// Системные библиотеки (только для реализации)
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+MiningTelemetry::MiningTelemetry(unsigned int workers, std::chrono::milliseconds interval, bool summary)
+    : counters(std::make_unique<WorkerCounter[]>(workers)),
+      workerCount(workers),
+      sampleInterval(interval),
+      printSummary(summary)
+{
+    lastSnapshot.threadHashRates.assign(workerCount, 0);
+    sampler = std::thread(&MiningTelemetry::samplerLoop, this);
+}
+
+MiningTelemetry::~MiningTelemetry()
+{
+    {
+        std::lock_guard<std::mutex> lock(snapshotMutex);
+        stopping = true;
+    }
+    stopCondition.notify_all();
+    sampler.join();
+}
+
+void MiningTelemetry::recordSolution(uint64_t solveTimeMs)
+{
+    lastSolveTimeMs.store(solveTimeMs, std::memory_order_relaxed);
+    totalSolveTimeMs.fetch_add(solveTimeMs, std::memory_order_relaxed);
+    blocksSolved.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MiningTelemetry::recordStaleJob()
+{
+    staleJobs.fetch_add(1, std::memory_order_relaxed);
+}
+
+MiningTelemetry::Snapshot MiningTelemetry::snapshot() const
+{
+    std::lock_guard<std::mutex> lock(snapshotMutex);
+    return lastSnapshot;
+}
+
+std::string MiningTelemetry::formatSummary(const Snapshot &snapshot)
+{
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(2)
+       << "Hash rate: " << snapshot.totalHashRate / 1e6 << " MH/s [";
+    for (size_t i = 0; i < snapshot.threadHashRates.size(); ++i)
+    {
+        ss << (i ? " " : "") << snapshot.threadHashRates[i] / 1e6;
+    }
+    ss << "] | Hashes: " << snapshot.totalHashes
+       << " | Blocks: " << snapshot.blocksSolved
+       << " | Last solve: " << snapshot.lastSolveTimeMs << " ms"
+       << " | Avg solve: " << snapshot.averageSolveTimeMs << " ms"
+       << " | Stale jobs: " << snapshot.staleJobs;
+    return ss.str();
+}
+
+void MiningTelemetry::samplerLoop()
+{
+    std::vector<uint64_t> previous(workerCount, 0);
+    auto previousTime = std::chrono::steady_clock::now();
+
+    std::unique_lock<std::mutex> lock(snapshotMutex);
+    while (!stopCondition.wait_for(lock, sampleInterval, [this]()
+                                   { return stopping; }))
+    {
+        const auto now = std::chrono::steady_clock::now();
+        const double seconds = std::chrono::duration<double>(now - previousTime).count();
+        previousTime = now;
+
+        Snapshot next;
+        next.threadHashRates.resize(workerCount);
+        uint64_t delta = 0;
+        for (unsigned int i = 0; i < workerCount; ++i)
+        {
+            const uint64_t current = counters[i].hashes.load(std::memory_order_relaxed);
+            const uint64_t threadDelta = current - previous[i];
+            previous[i] = current;
+
+            next.threadHashRates[i] = seconds > 0 ? static_cast<double>(threadDelta) / seconds : 0;
+            next.totalHashRate += next.threadHashRates[i];
+            next.totalHashes += current;
+            delta += threadDelta;
+        }
+
+        next.blocksSolved = blocksSolved.load(std::memory_order_relaxed);
+        next.staleJobs = staleJobs.load(std::memory_order_relaxed);
+        next.lastSolveTimeMs = lastSolveTimeMs.load(std::memory_order_relaxed);
+        next.averageSolveTimeMs = next.blocksSolved
+                                      ? static_cast<double>(totalSolveTimeMs.load(std::memory_order_relaxed)) / next.blocksSolved
+                                      : 0;
+        lastSnapshot = std::move(next);
+
+        // Итоговая строка печатается только при активном майнинге, вне горячего цикла
+        if (printSummary && delta > 0)
+        {
+            ConsoleUI::printMining(formatSummary(lastSnapshot));
+        }
+    }
+}
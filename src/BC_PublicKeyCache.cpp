@@ -0,0 +1,61 @@
+// BC_PublicKeyCache.cpp
+#include "BC_PublicKeyCache.h"
+#include "BC_CryptoUtils.h"
+#include "BC_Utilities.h"
+
+// Системные библиотеки (только для реализации)
+#include <mutex>
+
+PublicKeyCache::PublicKeyCache(const FlatStringMap<std::string> &publicKeys)
+{
+    for (const auto &[username, publicKeyPEM] : publicKeys)
+    {
+        setKey(std::string(username), publicKeyPEM);
+    }
+}
+
+bool PublicKeyCache::setKey(const std::string &username, const std::string &publicKeyPEM)
+{
+    // Разбор и отпечаток вычисляются вне блокировки, чтобы не задерживать проверяющие потоки
+    KeyEntry entry;
+    entry.key = CryptoUtils::loadPublicKey(publicKeyPEM);
+    if (entry.key)
+        entry.fingerprint = CryptoUtils::publicKeyFingerprint(entry.key.get());
+
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    if (!entry.key)
+    {
+        keys.erase(username);
+        ConsoleUI::printError("Failed to parse public key for " + username);
+        return false;
+    }
+
+    keys[username] = std::move(entry);
+    return true;
+}
+
+void PublicKeyCache::invalidate(std::string_view username)
+{
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    keys.erase(username);
+}
+
+PublicKeyCache::KeyHandle PublicKeyCache::find(std::string_view username) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    const KeyEntry *entry = keys.find(username);
+    return entry ? entry->key : nullptr;
+}
+
+PublicKeyCache::KeyEntry PublicKeyCache::findEntry(std::string_view username) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    const KeyEntry *entry = keys.find(username);
+    return entry ? *entry : KeyEntry();
+}
+
+size_t PublicKeyCache::size() const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return keys.size();
+}
@@ -0,0 +1,181 @@
+// BC_Sha256LaneKernel.h
+// Внутренний заголовок реализации Sha256Lanes: общее ядро сжатия SHA-256,
+// параметризованное набором векторных операций. Подключается только из
+// src/BC_Sha256Lanes*.cpp; каждая единица трансляции компилируется со своими
+// флагами набора инструкций, поэтому все определения имеют внутреннее связывание.
+#pragma once
+
+#include "BC_Sha256Lanes.h"
+
+// Системные библиотеки
+#include <cstdint>
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define BC_SHA256_X86_LANES 1
+#else
+#define BC_SHA256_X86_LANES 0
+#endif
+
+/// @cond INTERNAL
+/// Точки входа реализаций. Вызываются только после проверки возможностей процессора.
+void sha256LanesScalar(const Sha256Lanes::Midstate &midstate, uint64_t firstNonce, unsigned char *out);
+#if BC_SHA256_X86_LANES
+void sha256LanesSse41(const Sha256Lanes::Midstate &midstate, uint64_t firstNonce, unsigned char *out);
+void sha256LanesAvx2(const Sha256Lanes::Midstate &midstate, uint64_t firstNonce, unsigned char *out);
+void sha256LanesAvx512(const Sha256Lanes::Midstate &midstate, uint64_t firstNonce, unsigned char *out);
+#endif
+/// @endcond
+
+namespace
+{
+    // Константы раундов SHA-256 (FIPS 180-4)
+    constexpr uint32_t SHA256_K[64] = {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+    // Скалярные операции (одна линия)
+    struct ScalarOps
+    {
+        using type = uint32_t;
+        static constexpr size_t LANES = 1;
+
+        static type set1(uint32_t v) { return v; }
+        static type load(const uint32_t *p) { return *p; }
+        static void store(uint32_t *p, type v) { *p = v; }
+        static type add(type a, type b) { return a + b; }
+        static type bxor(type a, type b) { return a ^ b; }
+        static type band(type a, type b) { return a & b; }
+        static type bor(type a, type b) { return a | b; }
+        static type andnot(type a, type b) { return ~a & b; }
+        template <int N> static type rotr(type x) { return (x >> N) | (x << (32 - N)); }
+        template <int N> static type shr(type x) { return x >> N; }
+    };
+
+    // Слово хвоста с подставленными байтами nonce (nonce кодируется little-endian)
+    inline uint32_t tailWordWithNonce(const Sha256Lanes::Midstate &midstate, size_t wordIndex, uint64_t nonce)
+    {
+        uint32_t word = midstate.tailWords[wordIndex];
+        for (size_t k = 0; k < Sha256Lanes::NONCE_SIZE; ++k)
+        {
+            const size_t pos = midstate.nonceOffset + k;
+            if (pos / 4 == wordIndex)
+            {
+                word |= static_cast<uint32_t>((nonce >> (8 * k)) & 0xff) << (8 * (3 - pos % 4));
+            }
+        }
+        return word;
+    }
+
+    // Проверка, затрагивает ли слово байты nonce
+    inline bool wordHasNonce(const Sha256Lanes::Midstate &midstate, size_t wordIndex)
+    {
+        const size_t first = midstate.nonceOffset / 4;
+        const size_t last = (midstate.nonceOffset + Sha256Lanes::NONCE_SIZE - 1) / 4;
+        return wordIndex >= first && wordIndex <= last;
+    }
+
+    // Одно сжатие SHA-256 над всеми линиями сразу
+    template <class V>
+    inline void sha256Compress(typename V::type state[8], typename V::type w[16])
+    {
+        using T = typename V::type;
+        T a = state[0], b = state[1], c = state[2], d = state[3];
+        T e = state[4], f = state[5], g = state[6], h = state[7];
+
+        for (int i = 0; i < 64; ++i)
+        {
+            if (i >= 16)
+            {
+                const T w15 = w[(i - 15) & 15];
+                const T w2 = w[(i - 2) & 15];
+                const T s0 = V::bxor(V::bxor(V::template rotr<7>(w15), V::template rotr<18>(w15)), V::template shr<3>(w15));
+                const T s1 = V::bxor(V::bxor(V::template rotr<17>(w2), V::template rotr<19>(w2)), V::template shr<10>(w2));
+                w[i & 15] = V::add(V::add(w[i & 15], s0), V::add(w[(i - 7) & 15], s1));
+            }
+
+            const T bigS1 = V::bxor(V::bxor(V::template rotr<6>(e), V::template rotr<11>(e)), V::template rotr<25>(e));
+            const T ch = V::bxor(V::band(e, f), V::andnot(e, g));
+            const T t1 = V::add(V::add(V::add(h, bigS1), V::add(ch, V::set1(SHA256_K[i]))), w[i & 15]);
+            const T bigS0 = V::bxor(V::bxor(V::template rotr<2>(a), V::template rotr<13>(a)), V::template rotr<22>(a));
+            const T maj = V::bor(V::band(a, b), V::band(c, V::bor(a, b)));
+            const T t2 = V::add(bigS0, maj);
+
+            h = g;
+            g = f;
+            f = e;
+            e = V::add(d, t1);
+            d = c;
+            c = b;
+            b = a;
+            a = V::add(t1, t2);
+        }
+
+        state[0] = V::add(state[0], a);
+        state[1] = V::add(state[1], b);
+        state[2] = V::add(state[2], c);
+        state[3] = V::add(state[3], d);
+        state[4] = V::add(state[4], e);
+        state[5] = V::add(state[5], f);
+        state[6] = V::add(state[6], g);
+        state[7] = V::add(state[7], h);
+    }
+
+    // Хеширование V::LANES последовательных nonce от общего midstate
+    template <class V>
+    inline void sha256HashLanes(const Sha256Lanes::Midstate &midstate, uint64_t firstNonce, unsigned char *out)
+    {
+        using T = typename V::type;
+        constexpr size_t L = V::LANES;
+        alignas(64) uint32_t scratch[L];
+
+        T state[8];
+        for (size_t i = 0; i < 8; ++i)
+        {
+            state[i] = V::set1(midstate.state[i]);
+        }
+
+        for (size_t block = 0; block < midstate.tailBlocks; ++block)
+        {
+            T w[16];
+            for (size_t j = 0; j < 16; ++j)
+            {
+                const size_t wordIndex = block * 16 + j;
+                if (wordHasNonce(midstate, wordIndex))
+                {
+                    // Только слова с nonce различаются между линиями
+                    for (size_t lane = 0; lane < L; ++lane)
+                    {
+                        scratch[lane] = tailWordWithNonce(midstate, wordIndex, firstNonce + lane);
+                    }
+                    w[j] = V::load(scratch);
+                }
+                else
+                {
+                    w[j] = V::set1(midstate.tailWords[wordIndex]);
+                }
+            }
+            sha256Compress<V>(state, w);
+        }
+
+        // Транспонирование результата: линия -> big-endian хеш
+        for (size_t i = 0; i < 8; ++i)
+        {
+            V::store(scratch, state[i]);
+            for (size_t lane = 0; lane < L; ++lane)
+            {
+                unsigned char *dst = out + lane * Sha256Lanes::DIGEST_SIZE + 4 * i;
+                dst[0] = static_cast<unsigned char>(scratch[lane] >> 24);
+                dst[1] = static_cast<unsigned char>(scratch[lane] >> 16);
+                dst[2] = static_cast<unsigned char>(scratch[lane] >> 8);
+                dst[3] = static_cast<unsigned char>(scratch[lane]);
+            }
+        }
+    }
+}
@@ -0,0 +1,337 @@
+// BC_Sha256Lanes.cpp
+#include "BC_Sha256Lanes.h"
+#include "BC_Sha256LaneKernel.h"
+#include "BC_Utilities.h"
+
+// Системные библиотеки (только для реализации)
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#if BC_SHA256_X86_LANES && defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+// OpenSSL компоненты
+#include <openssl/sha.h>
+
+// Начальное состояние SHA-256 (FIPS 180-4)
+const uint32_t SHA256_INITIAL_STATE[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+const size_t SHA256_BLOCK_SIZE = 64;    // Размер блока сжатия в байтах
+
+void sha256LanesScalar(const Sha256Lanes::Midstate &midstate, uint64_t firstNonce, unsigned char *out)
+{
+    sha256HashLanes<ScalarOps>(midstate, firstNonce, out);
+}
+
+namespace
+{
+    using LaneFunction = void (*)(const Sha256Lanes::Midstate &, uint64_t, unsigned char *);
+
+    // Описание реализации
+    struct BackendEntry
+    {
+        Sha256Lanes::Backend backend;
+        size_t lanes;
+        LaneFunction function;
+    };
+
+    // Реализации в порядке убывания предпочтения
+    const BackendEntry BACKENDS[] = {
+#if BC_SHA256_X86_LANES
+        {Sha256Lanes::Backend::AVX512, 16, &sha256LanesAvx512},
+        {Sha256Lanes::Backend::AVX2, 8, &sha256LanesAvx2},
+        {Sha256Lanes::Backend::SSE41, 4, &sha256LanesSse41},
+#endif
+        {Sha256Lanes::Backend::Scalar, 1, &sha256LanesScalar},
+    };
+
+    const BackendEntry *findEntry(Sha256Lanes::Backend backend)
+    {
+        for (const auto &entry : BACKENDS)
+        {
+            if (entry.backend == backend)
+                return &entry;
+        }
+        return nullptr;
+    }
+
+    // Проверка поддержки набора инструкций процессором и ОС
+    bool cpuSupports(Sha256Lanes::Backend backend)
+    {
+        if (backend == Sha256Lanes::Backend::Scalar)
+            return true;
+
+#if BC_SHA256_X86_LANES
+#if defined(_MSC_VER) && !defined(__clang__)
+        int regs[4] = {0};
+        __cpuid(regs, 0);
+        const int maxLeaf = regs[0];
+
+        __cpuid(regs, 1);
+        const bool sse41 = (regs[2] & (1 << 19)) != 0;
+        const bool osxsave = (regs[2] & (1 << 27)) != 0;
+        const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+        const bool avxState = (xcr0 & 0x6) == 0x6;
+        const bool avx512State = (xcr0 & 0xE6) == 0xE6;
+
+        int ebx7 = 0;
+        if (maxLeaf >= 7)
+        {
+            __cpuidex(regs, 7, 0);
+            ebx7 = regs[1];
+        }
+
+        switch (backend)
+        {
+        case Sha256Lanes::Backend::SSE41:
+            return sse41;
+        case Sha256Lanes::Backend::AVX2:
+            return avxState && (ebx7 & (1 << 5)) != 0;
+        case Sha256Lanes::Backend::AVX512:
+            return avx512State && (ebx7 & (1 << 16)) != 0;
+        default:
+            return false;
+        }
+#else
+        __builtin_cpu_init();
+        switch (backend)
+        {
+        case Sha256Lanes::Backend::SSE41:
+            return __builtin_cpu_supports("sse4.1");
+        case Sha256Lanes::Backend::AVX2:
+            return __builtin_cpu_supports("avx2");
+        case Sha256Lanes::Backend::AVX512:
+            return __builtin_cpu_supports("avx512f");
+        default:
+            return false;
+        }
+#endif
+#else
+        return false;
+#endif
+    }
+
+    // Хеширует count nonce начиная с firstNonce пакетами реализации и сверяет с эталонами
+    bool matchesReference(const BackendEntry &entry, const std::string &prefix, uint64_t firstNonce, size_t count)
+    {
+        const Sha256Lanes::Midstate midstate = Sha256Lanes::prepare(prefix);
+        const size_t batches = (count + entry.lanes - 1) / entry.lanes;
+        std::vector<unsigned char> lanesOut(batches * entry.lanes * Sha256Lanes::DIGEST_SIZE);
+        for (size_t batch = 0; batch < batches; ++batch)
+        {
+            entry.function(midstate, firstNonce + batch * entry.lanes,
+                           lanesOut.data() + batch * entry.lanes * Sha256Lanes::DIGEST_SIZE);
+        }
+
+        // Лишние линии последнего пакета не сверяются, как и при переборе хвоста диапазона
+        for (size_t lane = 0; lane < count; ++lane)
+        {
+            std::string message = prefix;
+            const uint64_t nonce = firstNonce + lane;
+            for (size_t k = 0; k < Sha256Lanes::NONCE_SIZE; ++k)
+            {
+                message.push_back(static_cast<char>((nonce >> (8 * k)) & 0xff));
+            }
+
+            unsigned char expected[SHA256_DIGEST_LENGTH];
+            SHA256(reinterpret_cast<const unsigned char *>(message.data()), message.size(), expected);
+            unsigned char scalar[Sha256Lanes::DIGEST_SIZE];
+            sha256LanesScalar(midstate, nonce, scalar);
+
+            const unsigned char *actual = lanesOut.data() + lane * Sha256Lanes::DIGEST_SIZE;
+            if (std::memcmp(expected, actual, SHA256_DIGEST_LENGTH) != 0 ||
+                std::memcmp(scalar, actual, Sha256Lanes::DIGEST_SIZE) != 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Known-answer проверка реализации против OpenSSL SHA256() и скалярного кода
+    bool passesSelfTest(const BackendEntry &entry)
+    {
+        // Длины префикса покрывают один и два хвостовых блока, а также nonce на границе блоков
+        const size_t prefixLengths[] = {0, 1, 47, 48, 55, 56, 60, 63, 64, 100, 119, 200};
+        // Нулевой и нечетный первый nonce, перенос через границу 32 бит внутри пакета, старшие байты
+        const uint64_t firstNonces[] = {0, 1, 0x00000000FFFFFFF7ULL, 0x0123456789ABCDEFULL};
+        // Диапазоны короче пакета, на линию короче и длиннее, несколько пакетов с неполным хвостом
+        const size_t counts[] = {1, 3, entry.lanes - 1, entry.lanes + 1, 2 * entry.lanes + 3};
+
+        for (size_t length : prefixLengths)
+        {
+            std::string prefix(length, '\0');
+            for (size_t i = 0; i < length; ++i)
+            {
+                prefix[i] = static_cast<char>((i * 131 + 7) & 0xff);
+            }
+
+            for (uint64_t firstNonce : firstNonces)
+            {
+                for (size_t count : counts)
+                {
+                    if (count != 0 && !matchesReference(entry, prefix, firstNonce, count))
+                        return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    bool isUsable(const BackendEntry &entry)
+    {
+        if (!cpuSupports(entry.backend))
+            return false;
+        if (!passesSelfTest(entry))
+        {
+            ConsoleUI::printWarning(std::string("SHA-256 backend ") + Sha256Lanes::backendName(entry.backend) +
+                                    " failed self-test and is disabled");
+            return false;
+        }
+        return true;
+    }
+
+    std::atomic<const BackendEntry *> activeEntry{nullptr};
+
+    const BackendEntry &currentEntry()
+    {
+        static std::once_flag detected;
+        std::call_once(detected, []()
+                       {
+            for (const auto &entry : BACKENDS)
+            {
+                if (isUsable(entry))
+                {
+                    const BackendEntry *expected = nullptr;
+                    activeEntry.compare_exchange_strong(expected, &entry);
+                    break;
+                }
+            } });
+        return *activeEntry.load(std::memory_order_acquire);
+    }
+}
+
+Sha256Lanes::Midstate Sha256Lanes::prepare(const std::string &prefix)
+{
+    Midstate midstate{};
+    std::memcpy(midstate.state, SHA256_INITIAL_STATE, sizeof(midstate.state));
+
+    const auto *bytes = reinterpret_cast<const unsigned char *>(prefix.data());
+    const size_t fullBlocks = prefix.size() / SHA256_BLOCK_SIZE;
+
+    // Полные блоки префикса сжимаются один раз
+    for (size_t block = 0; block < fullBlocks; ++block)
+    {
+        uint32_t w[16];
+        const unsigned char *p = bytes + block * SHA256_BLOCK_SIZE;
+        for (size_t j = 0; j < 16; ++j)
+        {
+            w[j] = (static_cast<uint32_t>(p[4 * j]) << 24) | (static_cast<uint32_t>(p[4 * j + 1]) << 16) |
+                   (static_cast<uint32_t>(p[4 * j + 2]) << 8) | static_cast<uint32_t>(p[4 * j + 3]);
+        }
+        sha256Compress<ScalarOps>(midstate.state, w);
+    }
+
+    // Хвост: остаток префикса, место под nonce, паддинг 0x80 и длина сообщения в битах
+    const size_t remainder = prefix.size() - fullBlocks * SHA256_BLOCK_SIZE;
+    midstate.nonceOffset = remainder;
+    midstate.tailBlocks = (remainder + NONCE_SIZE + 1 + 8 <= SHA256_BLOCK_SIZE) ? 1 : 2;
+
+    unsigned char tail[2 * SHA256_BLOCK_SIZE] = {0};
+    std::memcpy(tail, bytes + fullBlocks * SHA256_BLOCK_SIZE, remainder);
+    tail[remainder + NONCE_SIZE] = 0x80;
+
+    const uint64_t bitLength = static_cast<uint64_t>(prefix.size() + NONCE_SIZE) * 8;
+    const size_t tailSize = midstate.tailBlocks * SHA256_BLOCK_SIZE;
+    for (size_t k = 0; k < 8; ++k)
+    {
+        tail[tailSize - 1 - k] = static_cast<unsigned char>(bitLength >> (8 * k));
+    }
+
+    for (size_t j = 0; j < midstate.tailBlocks * 16; ++j)
+    {
+        midstate.tailWords[j] = (static_cast<uint32_t>(tail[4 * j]) << 24) | (static_cast<uint32_t>(tail[4 * j + 1]) << 16) |
+                                (static_cast<uint32_t>(tail[4 * j + 2]) << 8) | static_cast<uint32_t>(tail[4 * j + 3]);
+    }
+
+    return midstate;
+}
+
+void Sha256Lanes::hashNonces(const Midstate &midstate, uint64_t firstNonce, unsigned char *out)
+{
+    currentEntry().function(midstate, firstNonce, out);
+}
+
+void Sha256Lanes::hashNonces(Backend backend, const Midstate &midstate, uint64_t firstNonce, unsigned char *out)
+{
+    const BackendEntry *entry = findEntry(backend);
+    if (!entry)
+        throw std::invalid_argument(std::string("SHA-256 backend is not built: ") + backendName(backend));
+    entry->function(midstate, firstNonce, out);
+}
+
+void Sha256Lanes::hashNonce(const Midstate &midstate, uint64_t nonce, unsigned char *out)
+{
+    sha256LanesScalar(midstate, nonce, out);
+}
+
+size_t Sha256Lanes::laneCount()
+{
+    return currentEntry().lanes;
+}
+
+Sha256Lanes::Backend Sha256Lanes::activeBackend()
+{
+    return currentEntry().backend;
+}
+
+bool Sha256Lanes::selectBackend(Backend backend)
+{
+    currentEntry(); // Гарантирует завершение автоопределения
+
+    const BackendEntry *entry = findEntry(backend);
+    if (!entry || !isUsable(*entry))
+        return false;
+
+    activeEntry.store(entry, std::memory_order_release);
+    return true;
+}
+
+const char *Sha256Lanes::backendName(Backend backend)
+{
+    switch (backend)
+    {
+    case Backend::Scalar:
+        return "scalar";
+    case Backend::SSE41:
+        return "sse4.1";
+    case Backend::AVX2:
+        return "avx2";
+    case Backend::AVX512:
+        return "avx512";
+    }
+    return "unknown";
+}
+
+size_t Sha256Lanes::lanesOf(Backend backend)
+{
+    const BackendEntry *entry = findEntry(backend);
+    return entry ? entry->lanes : 0;
+}
+
+Sha256Lanes::CheckResult Sha256Lanes::verifyBackend(Backend backend)
+{
+    const BackendEntry *entry = findEntry(backend);
+    if (!entry)
+        return CheckResult::NotBuilt;
+    if (!cpuSupports(backend))
+        return CheckResult::Unsupported;
+    return passesSelfTest(*entry) ? CheckResult::Passed : CheckResult::Failed;
+}
@@ -0,0 +1,32 @@
+// BC_Sha256Lanes_AVX2.cpp
+// Компилируется с поддержкой AVX2 (см. CMakeLists.txt)
+#include "BC_Sha256LaneKernel.h"
+
+#if BC_SHA256_X86_LANES
+#include <immintrin.h>
+
+namespace
+{
+    struct Avx2Ops
+    {
+        using type = __m256i;
+        static constexpr size_t LANES = 8;
+
+        static type set1(uint32_t v) { return _mm256_set1_epi32(static_cast<int>(v)); }
+        static type load(const uint32_t *p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)); }
+        static void store(uint32_t *p, type v) { _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v); }
+        static type add(type a, type b) { return _mm256_add_epi32(a, b); }
+        static type bxor(type a, type b) { return _mm256_xor_si256(a, b); }
+        static type band(type a, type b) { return _mm256_and_si256(a, b); }
+        static type bor(type a, type b) { return _mm256_or_si256(a, b); }
+        static type andnot(type a, type b) { return _mm256_andnot_si256(a, b); }
+        template <int N> static type rotr(type x) { return _mm256_or_si256(_mm256_srli_epi32(x, N), _mm256_slli_epi32(x, 32 - N)); }
+        template <int N> static type shr(type x) { return _mm256_srli_epi32(x, N); }
+    };
+}
+
+void sha256LanesAvx2(const Sha256Lanes::Midstate &midstate, uint64_t firstNonce, unsigned char *out)
+{
+    sha256HashLanes<Avx2Ops>(midstate, firstNonce, out);
+}
+#endif
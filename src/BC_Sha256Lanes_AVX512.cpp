@@ -0,0 +1,32 @@
+// BC_Sha256Lanes_AVX512.cpp
+// Компилируется с поддержкой AVX-512F (см. CMakeLists.txt)
+#include "BC_Sha256LaneKernel.h"
+
+#if BC_SHA256_X86_LANES
+#include <immintrin.h>
+
+namespace
+{
+    struct Avx512Ops
+    {
+        using type = __m512i;
+        static constexpr size_t LANES = 16;
+
+        static type set1(uint32_t v) { return _mm512_set1_epi32(static_cast<int>(v)); }
+        static type load(const uint32_t *p) { return _mm512_loadu_si512(p); }
+        static void store(uint32_t *p, type v) { _mm512_storeu_si512(p, v); }
+        static type add(type a, type b) { return _mm512_add_epi32(a, b); }
+        static type bxor(type a, type b) { return _mm512_xor_si512(a, b); }
+        static type band(type a, type b) { return _mm512_and_si512(a, b); }
+        static type bor(type a, type b) { return _mm512_or_si512(a, b); }
+        static type andnot(type a, type b) { return _mm512_andnot_si512(a, b); }
+        template <int N> static type rotr(type x) { return _mm512_ror_epi32(x, N); }
+        template <int N> static type shr(type x) { return _mm512_srli_epi32(x, N); }
+    };
+}
+
+void sha256LanesAvx512(const Sha256Lanes::Midstate &midstate, uint64_t firstNonce, unsigned char *out)
+{
+    sha256HashLanes<Avx512Ops>(midstate, firstNonce, out);
+}
+#endif
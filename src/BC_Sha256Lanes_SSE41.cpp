@@ -0,0 +1,32 @@
+// BC_Sha256Lanes_SSE41.cpp
+// Компилируется с поддержкой SSE4.1 (см. CMakeLists.txt)
+#include "BC_Sha256LaneKernel.h"
+
+#if BC_SHA256_X86_LANES
+#include <immintrin.h>
+
+namespace
+{
+    struct Sse41Ops
+    {
+        using type = __m128i;
+        static constexpr size_t LANES = 4;
+
+        static type set1(uint32_t v) { return _mm_set1_epi32(static_cast<int>(v)); }
+        static type load(const uint32_t *p) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+        static void store(uint32_t *p, type v) { _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v); }
+        static type add(type a, type b) { return _mm_add_epi32(a, b); }
+        static type bxor(type a, type b) { return _mm_xor_si128(a, b); }
+        static type band(type a, type b) { return _mm_and_si128(a, b); }
+        static type bor(type a, type b) { return _mm_or_si128(a, b); }
+        static type andnot(type a, type b) { return _mm_andnot_si128(a, b); }
+        template <int N> static type rotr(type x) { return _mm_or_si128(_mm_srli_epi32(x, N), _mm_slli_epi32(x, 32 - N)); }
+        template <int N> static type shr(type x) { return _mm_srli_epi32(x, N); }
+    };
+}
+
+void sha256LanesSse41(const Sha256Lanes::Midstate &midstate, uint64_t firstNonce, unsigned char *out)
+{
+    sha256HashLanes<Sse41Ops>(midstate, firstNonce, out);
+}
+#endif
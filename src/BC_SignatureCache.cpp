@@ -0,0 +1,104 @@
+// BC_SignatureCache.cpp
+#include "BC_SignatureCache.h"
+#include "BC_CryptoContexts.h"
+
+// Системные библиотеки (только для реализации)
+#include <stdexcept>
+
+// OpenSSL компоненты
+#include <openssl/evp.h>
+
+SignatureCache::SignatureCache(size_t capacity)
+    : capacity(capacity),
+      shardCapacity((capacity + SHARD_COUNT - 1) / SHARD_COUNT)
+{
+}
+
+CryptoUtils::Digest SignatureCache::signatureDigest(std::string_view signedData,
+                                                    CryptoUtils::SignatureView signature)
+{
+    CryptoContexts::DigestLease lease;
+    CryptoUtils::Digest digest{};
+    unsigned int length = 0;
+
+    if (EVP_DigestInit_ex(lease.get(), CryptoContexts::sha256(), nullptr) != 1 ||
+        EVP_DigestUpdate(lease.get(), signedData.data(), signedData.size()) != 1 ||
+        EVP_DigestUpdate(lease.get(), signature.data(), signature.size()) != 1 ||
+        EVP_DigestFinal_ex(lease.get(), digest.data(), &length) != 1)
+    {
+        throw std::runtime_error("Signature digest calculation failed");
+    }
+    return digest;
+}
+
+void SignatureCache::insert(const Hash256 &txId, const Entry &entry)
+{
+    if (capacity == 0)
+        return;
+
+    Shard &shard = shardFor(txId);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto [it, inserted] = shard.entries.insert_or_assign(txId, entry);
+    if (!inserted)
+        return;
+
+    shard.order.push_back(txId);
+    if (shard.order.size() > shardCapacity)
+    {
+        shard.entries.erase(shard.order.front());
+        shard.order.pop_front();
+    }
+}
+
+bool SignatureCache::contains(const Hash256 &txId, const Entry &entry) const
+{
+    if (capacity == 0)
+        return false;
+
+    const Shard &shard = shardFor(txId);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.entries.find(txId);
+    return it != shard.entries.end() &&
+           it->second.signatureDigest == entry.signatureDigest &&
+           it->second.keyFingerprint == entry.keyFingerprint;
+}
+
+void SignatureCache::clear()
+{
+    for (Shard &shard : shards)
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.entries.clear();
+        shard.order.clear();
+    }
+}
+
+size_t SignatureCache::size() const
+{
+    size_t total = 0;
+    for (const Shard &shard : shards)
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        total += shard.entries.size();
+    }
+    return total;
+}
+
+size_t SignatureCache::getCapacity() const
+{
+    return capacity;
+}
+
+SignatureCache::Shard &SignatureCache::shardFor(const Hash256 &txId)
+{
+    // Последний байт, чтобы выбор сегмента не коррелировал с корзинами std::hash<Hash256>
+    return shards[txId.data()[Hash256::SIZE - 1] % SHARD_COUNT];
+}
+
+const SignatureCache::Shard &SignatureCache::shardFor(const Hash256 &txId) const
+{
+    // Последний байт, чтобы выбор сегмента не коррелировал с корзинами std::hash<Hash256>
+    return shards[txId.data()[Hash256::SIZE - 1] % SHARD_COUNT];
+}
@@ -0,0 +1,225 @@
+// BC_SignatureScheme.cpp
+#include "BC_SignatureScheme.h"
+#include "BC_RSAKeyGenerator.h"
+#include "BC_CryptoContexts.h"
+#include "BC_Utilities.h"
+
+// OpenSSL компоненты
+#include <openssl/rsa.h>
+#include <openssl/ec.h>
+#include <openssl/obj_mac.h>
+#include <openssl/objects.h>
+#include <openssl/err.h>
+
+// Параметры схем
+const int RSA_KEY_BITS = 2048;                          // Длина ключа RSA
+const int RSA_PADDING_MODE = RSA_PKCS1_PADDING;         // Паддинг подписи RSA
+const int P256_CURVE_NID = NID_X9_62_prime256v1;        // Кривая ECDSA
+
+namespace
+{
+    /// @brief Логирует ошибку вместе с последней ошибкой OpenSSL
+    void printOpenSSLError(const std::string &message)
+    {
+        char opensslError[256] = {0};
+        ERR_error_string_n(ERR_get_error(), opensslError, sizeof(opensslError));
+        ConsoleUI::printError(message + ": " + opensslError);
+    }
+
+    /// @brief Генерация ключа по идентификатору типа с необязательной настройкой контекста
+    template <typename Configure>
+    EVP_PKEY *generateKey(int keyType, Configure configure)
+    {
+        EVP_PKEY_CTX *ctx = EVP_PKEY_CTX_new_id(keyType, nullptr);
+        if (!ctx)
+        {
+            printOpenSSLError("EVP_PKEY_CTX_new_id failed");
+            return nullptr;
+        }
+
+        EVP_PKEY *pkey = nullptr;
+        if (EVP_PKEY_keygen_init(ctx) <= 0 || !configure(ctx) || EVP_PKEY_keygen(ctx, &pkey) <= 0)
+        {
+            printOpenSSLError("Key generation failed");
+            pkey = nullptr;
+        }
+
+        EVP_PKEY_CTX_free(ctx);
+        return pkey;
+    }
+
+    class Rsa2048Scheme : public SignatureScheme
+    {
+    public:
+        Algorithm algorithm() const override { return Algorithm::RSA2048; }
+        const char *name() const override { return "rsa2048"; }
+        EVP_PKEY *generateKeyPair() const override { return RSAKeyGenerator::generateRSAKeyPair(RSA_KEY_BITS); }
+
+    protected:
+        const EVP_MD *digest() const override { return CryptoContexts::sha256(); }
+        bool configure(EVP_PKEY_CTX *keyContext) const override
+        {
+            return EVP_PKEY_CTX_set_rsa_padding(keyContext, RSA_PADDING_MODE) > 0;
+        }
+    };
+
+    class Ed25519Scheme : public SignatureScheme
+    {
+    public:
+        Algorithm algorithm() const override { return Algorithm::Ed25519; }
+        const char *name() const override { return "ed25519"; }
+        EVP_PKEY *generateKeyPair() const override
+        {
+            return generateKey(EVP_PKEY_ED25519, [](EVP_PKEY_CTX *)
+                               { return true; });
+        }
+
+    protected:
+        const EVP_MD *digest() const override { return nullptr; }
+    };
+
+    class EcdsaP256Scheme : public SignatureScheme
+    {
+    public:
+        Algorithm algorithm() const override { return Algorithm::EcdsaP256; }
+        const char *name() const override { return "p256"; }
+        EVP_PKEY *generateKeyPair() const override
+        {
+            return generateKey(EVP_PKEY_EC, [](EVP_PKEY_CTX *ctx)
+                               { return EVP_PKEY_CTX_set_ec_paramgen_curve_nid(ctx, P256_CURVE_NID) > 0; });
+        }
+
+    protected:
+        const EVP_MD *digest() const override { return CryptoContexts::sha256(); }
+    };
+
+    const Rsa2048Scheme RSA2048_SCHEME;
+    const Ed25519Scheme ED25519_SCHEME;
+    const EcdsaP256Scheme ECDSA_P256_SCHEME;
+}
+
+bool SignatureScheme::configure(EVP_PKEY_CTX *) const
+{
+    return true;
+}
+
+CryptoUtils::Signature SignatureScheme::sign(EVP_PKEY *privateKey, std::string_view data) const
+{
+    CryptoUtils::Signature signature;
+    if (!privateKey)
+        return signature;
+
+    // Контекст потока переиспользуется между вызовами (без выделения памяти)
+    CryptoContexts::DigestLease lease;
+    EVP_MD_CTX *ctx = lease.get();
+    if (!ctx)
+    {
+        printOpenSSLError("EVP_MD_CTX_new failed");
+        return signature;
+    }
+
+    // Однопроходная подпись: единый путь для схем с внешним хешем и для Ed25519
+    EVP_PKEY_CTX *keyContext = nullptr;
+    size_t signatureLength = 0;
+    if (EVP_DigestSignInit(ctx, &keyContext, digest(), nullptr, privateKey) != 1 || !configure(keyContext))
+    {
+        printOpenSSLError(std::string("EVP_DigestSignInit failed (") + name() + ")");
+    }
+    else if (EVP_DigestSign(ctx, nullptr, &signatureLength,
+                            reinterpret_cast<const unsigned char *>(data.data()), data.size()) != 1)
+    {
+        printOpenSSLError("EVP_DigestSign (length) failed");
+    }
+    else
+    {
+        signature.resize(signatureLength);
+        if (EVP_DigestSign(ctx, signature.data(), &signatureLength,
+                           reinterpret_cast<const unsigned char *>(data.data()), data.size()) != 1)
+        {
+            printOpenSSLError("EVP_DigestSign failed");
+            signature.clear();
+        }
+        else
+        {
+            signature.resize(signatureLength); // DER-подпись ECDSA может быть короче максимума
+        }
+    }
+
+    return signature;
+}
+
+bool SignatureScheme::verify(EVP_PKEY *publicKey, std::string_view data, CryptoUtils::SignatureView signature) const
+{
+    if (!publicKey || signature.empty())
+        return false;
+
+    CryptoContexts::DigestLease lease;
+    EVP_MD_CTX *ctx = lease.get();
+    if (!ctx)
+    {
+        ConsoleUI::printError("EVP_MD_CTX_new failed");
+        return false;
+    }
+
+    EVP_PKEY_CTX *keyContext = nullptr;
+    bool verificationResult = false;
+    if (EVP_DigestVerifyInit(ctx, &keyContext, digest(), nullptr, publicKey) == 1 && configure(keyContext))
+    {
+        verificationResult = EVP_DigestVerify(ctx, signature.data(), signature.size(),
+                                              reinterpret_cast<const unsigned char *>(data.data()), data.size()) == 1;
+    }
+    // Неверная подпись - штатный результат, очередь ошибок OpenSSL не должна накапливаться
+    ERR_clear_error();
+
+    return verificationResult;
+}
+
+const SignatureScheme &SignatureScheme::get(Algorithm algorithm)
+{
+    switch (algorithm)
+    {
+    case Algorithm::Ed25519:
+        return ED25519_SCHEME;
+    case Algorithm::EcdsaP256:
+        return ECDSA_P256_SCHEME;
+    case Algorithm::RSA2048:
+    default:
+        return RSA2048_SCHEME;
+    }
+}
+
+const SignatureScheme *SignatureScheme::forKey(EVP_PKEY *key)
+{
+    if (!key)
+        return nullptr;
+
+    // Тип ключа не определяет параметры: RSA другой длины и EC на другой кривой не подходят схемам
+    switch (EVP_PKEY_base_id(key))
+    {
+    case EVP_PKEY_RSA:
+        return EVP_PKEY_get_bits(key) == RSA_KEY_BITS ? &RSA2048_SCHEME : nullptr;
+    case EVP_PKEY_ED25519:
+        return &ED25519_SCHEME;
+    case EVP_PKEY_EC:
+    {
+        char group[64] = {0};
+        size_t groupLength = 0;
+        if (EVP_PKEY_get_group_name(key, group, sizeof(group), &groupLength) != 1)
+            return nullptr;
+        return OBJ_sn2nid(group) == P256_CURVE_NID ? &ECDSA_P256_SCHEME : nullptr;
+    }
+    default:
+        return nullptr;
+    }
+}
+
+const SignatureScheme *SignatureScheme::fromName(const std::string &name)
+{
+    if (name == "rsa2048" || name == "rsa")
+        return &RSA2048_SCHEME;
+    if (name == "ed25519")
+        return &ED25519_SCHEME;
+    if (name == "p256" || name == "ecdsa")
+        return &ECDSA_P256_SCHEME;
+    return nullptr;
+}
@@ -0,0 +1,173 @@
+// BC_Target.cpp
+#include "BC_Target.h"
+#include "BC_CryptoUtils.h"
+
+// Системные библиотеки (только для реализации)
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+// Максимальное изменение сложности за один шаг пересчета
+const uint32_t MAX_RETARGET_FACTOR = 4;
+
+Target256::Target256()
+{
+    value.fill(0);
+}
+
+Target256 Target256::fromCompact(uint32_t bits)
+{
+    Target256 target;
+    const uint32_t size = bits >> 24;
+    uint32_t mantissa = bits & 0x007fffff;
+
+    // Отрицательная мантисса недопустима
+    if (bits & 0x00800000)
+        return target;
+
+    if (size <= 3)
+    {
+        mantissa >>= 8 * (3 - size);
+        for (size_t i = 0; i < 3; ++i)
+        {
+            target.value[SIZE - 1 - i] = static_cast<unsigned char>(mantissa >> (8 * i));
+        }
+        return target;
+    }
+
+    // Мантисса не помещается в 256 бит
+    if (size > SIZE)
+        return Target256();
+
+    for (size_t i = 0; i < 3; ++i)
+    {
+        target.value[SIZE - size + i] = static_cast<unsigned char>(mantissa >> (8 * (2 - i)));
+    }
+    return target;
+}
+
+Target256 Target256::powLimit()
+{
+    return fromCompact(POW_LIMIT_BITS);
+}
+
+uint32_t Target256::toCompact() const
+{
+    size_t first = 0;
+    while (first < SIZE && value[first] == 0)
+        ++first;
+    if (first == SIZE)
+        return 0;
+
+    uint32_t size = static_cast<uint32_t>(SIZE - first);
+    uint32_t mantissa = 0;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        mantissa <<= 8;
+        if (first + i < SIZE)
+            mantissa |= value[first + i];
+    }
+
+    // Старший бит мантиссы зарезервирован под знак
+    if (mantissa & 0x00800000)
+    {
+        mantissa >>= 8;
+        ++size;
+    }
+    return (size << 24) | mantissa;
+}
+
+bool Target256::isMetBy(const unsigned char *digest) const
+{
+    return std::memcmp(digest, value.data(), SIZE) <= 0;
+}
+
+Target256 Target256::scaled(uint32_t numerator, uint32_t denominator) const
+{
+    if (denominator == 0)
+        throw std::invalid_argument("Target scale denominator is zero");
+
+    // Умножение на 32-битное число: 8 слов little-endian + слово переполнения
+    uint32_t limbs[9] = {0};
+    uint64_t carry = 0;
+    for (size_t i = 0; i < 8; ++i)
+    {
+        const size_t pos = SIZE - 4 * (i + 1);
+        const uint32_t word = (static_cast<uint32_t>(value[pos]) << 24) | (static_cast<uint32_t>(value[pos + 1]) << 16) |
+                              (static_cast<uint32_t>(value[pos + 2]) << 8) | static_cast<uint32_t>(value[pos + 3]);
+        const uint64_t product = static_cast<uint64_t>(word) * numerator + carry;
+        limbs[i] = static_cast<uint32_t>(product);
+        carry = product >> 32;
+    }
+    limbs[8] = static_cast<uint32_t>(carry);
+
+    // Деление столбиком от старших слов к младшим
+    uint64_t remainder = 0;
+    for (size_t i = 9; i-- > 0;)
+    {
+        const uint64_t current = (remainder << 32) | limbs[i];
+        limbs[i] = static_cast<uint32_t>(current / denominator);
+        remainder = current % denominator;
+    }
+
+    Target256 result;
+    if (limbs[8] != 0)
+    {
+        result.value.fill(0xff);
+        return result;
+    }
+
+    for (size_t i = 0; i < 8; ++i)
+    {
+        const size_t pos = SIZE - 4 * (i + 1);
+        result.value[pos] = static_cast<unsigned char>(limbs[i] >> 24);
+        result.value[pos + 1] = static_cast<unsigned char>(limbs[i] >> 16);
+        result.value[pos + 2] = static_cast<unsigned char>(limbs[i] >> 8);
+        result.value[pos + 3] = static_cast<unsigned char>(limbs[i]);
+    }
+    return result;
+}
+
+int Target256::leadingZeroBits() const
+{
+    int bits = 0;
+    for (unsigned char byte : value)
+    {
+        if (byte == 0)
+        {
+            bits += 8;
+            continue;
+        }
+        for (unsigned char mask = 0x80; mask && !(byte & mask); mask >>= 1)
+            ++bits;
+        break;
+    }
+    return bits;
+}
+
+std::string Target256::toHex() const
+{
+    return CryptoUtils::toHex(value.data(), SIZE);
+}
+
+uint32_t Target256::retarget(uint32_t bits, uint32_t actualMs, uint32_t expectedMs)
+{
+    if (expectedMs == 0)
+        return bits;
+
+    // Ограничение шага, чтобы одна аномальная выборка не обрушила сложность.
+    // Границы в 64 битах: expectedMs * MAX_RETARGET_FACTOR может не поместиться в uint32_t,
+    // а результат не превышает actualMs или нижней границы и помещается
+    const uint64_t lowestMs = expectedMs / MAX_RETARGET_FACTOR;
+    const uint64_t highestMs = static_cast<uint64_t>(expectedMs) * MAX_RETARGET_FACTOR;
+    actualMs = static_cast<uint32_t>(std::clamp<uint64_t>(actualMs, lowestMs, highestMs));
+    if (actualMs == 0)
+        actualMs = 1;
+
+    Target256 next = fromCompact(bits).scaled(actualMs, expectedMs);
+    const Target256 limit = powLimit();
+    if (next > limit)
+        next = limit;
+
+    return next.toCompact();
+}
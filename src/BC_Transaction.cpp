@@ -2,6 +2,7 @@
 #include "BC_Transaction.h"
 #include "BC_CryptoUtils.h"
 #include "BC_Utilities.h"
+#include "BC_Encoding.h"
 
 // Системные библиотеки (только для реализации)
 #include <sstream>
@@ -9,25 +10,40 @@
 // Реализация методов Transaction
 Transaction::Transaction(const std::string &from,
                          const std::string &to,
-                         double value,
+                         Amount value,
                          const std::string &meta)
     : sender(Validator::isAddressFormatValid(from) ? from : ""),
       receiver(Validator::isAddressFormatValid(to) ? to : ""),
       amount(value > 0 ? value : 0),
+      timestamp(TimeUtils::now()),
       metadata(meta)
 {
-    // Генерация уникального идентификатора транзакции
-    const std::string timePoint = TimeUtils::getCurrentTime();
-    timestamp = timePoint;
-    txId = CryptoUtils::calculateHash(
-        sender + receiver + std::to_string(amount) + timePoint + meta);
+    // Поля кодируются один раз: txId, подпись и хеш блока используют это представление
+    std::string fields;
+    encodeFields(fields);
+    txId = Hash256(CryptoUtils::calculateDigest(fields));
+
+    encoded.reserve(Hash256::SIZE + fields.size() + sizeof(uint32_t));
+    txId.appendTo(encoded);
+    encoded += fields;
+    signedLength = encoded.size();
+    encodeSignature();
+}
+
+void Transaction::encodeFields(std::string &out) const
+{
+    Encoding::appendU8(out, ENCODING_VERSION);
+    Encoding::appendString(out, sender);
+    Encoding::appendString(out, receiver);
+    Encoding::appendU64(out, static_cast<uint64_t>(amount));
+    Encoding::appendU64(out, static_cast<uint64_t>(timestamp));
+    Encoding::appendString(out, metadata);
 }
 
-std::string Transaction::getDataToSign() const
+void Transaction::encodeSignature()
 {
-    // Формируем детерминированную строку для подписи
-    return txId + sender + receiver +
-           std::to_string(amount) + timestamp + metadata;
+    encoded.resize(signedLength);
+    Encoding::appendBytes(encoded, signature.data(), signature.size());
 }
 
 void Transaction::signTransaction(const std::string &privateKeyPEM)
@@ -43,15 +59,17 @@ void Transaction::signTransaction(const std::string &privateKeyPEM)
         throw std::runtime_error("Invalid transaction parameters");
     }
 
-    std::string dataToSign = getDataToSign();
+    const std::string_view dataToSign = getSigningData();
     ConsoleUI::printInfo(
-        "Transaction signing initiated: " + txId +
-        "\nData to sign: [" + dataToSign + "]\n");
+        "Transaction signing initiated: " + txId.toHex() +
+        "\nData to sign: " + std::to_string(dataToSign.size()) + " bytes [" +
+        CryptoUtils::toHex(reinterpret_cast<const unsigned char *>(dataToSign.data()), dataToSign.size()) + "]\n");
 
-    ConsoleUI::printInfo("Starting digital signature verification for transaction " + txId);
+    ConsoleUI::printInfo("Starting digital signature verification for transaction " + txId.toHex());
 
     // Попытка криптографической подписи данных
     signature = CryptoUtils::signData(dataToSign, privateKeyPEM);
+    encodeSignature();
 }
 
 std::string Transaction::toString() const
@@ -60,19 +78,30 @@ std::string Transaction::toString() const
     ss << "txId: " << getTxId() << ", ";
     ss << "From: " << getSender() << ", ";
     ss << "To: " << getReceiver() << ", ";
-    ss << "Amount: " << std::fixed << getAmount() << " BTC\n"
+    ss << "Amount: " << AmountUtils::format(getAmount()) << " BTC\n"
        << ", ";
-    ss << "Timestamp: " << getTimestamp() << ", ";
+    ss << "Timestamp: " << TimeUtils::toIso8601(timestamp) << ", ";
     ss << "Metadata: " << metadata << ", ";
-    ss << "Signature: " << getSignature();
+    ss << "Signature: " << getSignatureHex();
     return ss.str();
 }
 
+void Transaction::bindAccounts(AccountId sender, AccountId receiver)
+{
+    senderId = sender;
+    receiverId = receiver;
+}
+
 // Геттеры
-const std::string &Transaction::getTxId() const { return txId; }
+AccountId Transaction::getSenderId() const { return senderId; }
+AccountId Transaction::getReceiverId() const { return receiverId; }
+std::string_view Transaction::getSigningData() const { return std::string_view(encoded.data(), signedLength); }
+const std::string &Transaction::getEncoded() const { return encoded; }
+const Hash256 &Transaction::getTxId() const { return txId; }
 const std::string &Transaction::getSender() const { return sender; }
-const std::string &Transaction::getSignature() const { return signature; }
+const std::vector<unsigned char> &Transaction::getSignature() const { return signature; }
+std::string Transaction::getSignatureHex() const { return CryptoUtils::toHex(signature.data(), signature.size()); }
 const std::string &Transaction::getReceiver() const { return receiver; }
-const std::string &Transaction::getTimestamp() const { return timestamp; }
+Timestamp Transaction::getTimestamp() const { return timestamp; }
 const std::string &Transaction::getMetadata() const { return metadata; }
-const double &Transaction::getAmount() const { return amount; }
\ No newline at end of file
+const Amount &Transaction::getAmount() const { return amount; }
\ No newline at end of file
@@ -1,10 +1,14 @@
 // BC_Utilities.cpp
 #include "BC_Utilities.h"
+#include "BC_CryptoContexts.h"
 
 // Системные библиотеки (только для реализации)
 #include <iostream>
-#include <iomanip>
-#include <sstream>
+#include <cstring>
+#include <cstdio>
+#include <ctime>
+#include <chrono>
+#include <atomic>
 
 // OpenSSL компоненты
 #include <openssl/evp.h>
@@ -100,21 +104,53 @@ void ConsoleUI::printMenu(std::string &user)
 }
 
 // Реализация методов TimeUtils
-std::string TimeUtils::getCurrentTime()
+Timestamp TimeUtils::now()
 {
-    std::time_t now = std::time(nullptr);
+    using namespace std::chrono;
+
+    // Опорная точка: системное время и показание монотонных часов в один момент
+    static const Timestamp wallAnchor = duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count();
+    static const steady_clock::time_point steadyAnchor = steady_clock::now();
+    static std::atomic<Timestamp> last{0};
+
+    const Timestamp current = wallAnchor + duration_cast<nanoseconds>(steady_clock::now() - steadyAnchor).count();
+
+    // Строгое возрастание: при совпадении показаний метка сдвигается на 1 нс
+    Timestamp previous = last.load(std::memory_order_relaxed);
+    Timestamp next;
+    do
+    {
+        next = current > previous ? current : previous + 1;
+    } while (!last.compare_exchange_weak(previous, next, std::memory_order_relaxed));
+
+    return next;
+}
+
+std::string TimeUtils::toIso8601(Timestamp timestamp)
+{
+    constexpr Timestamp NANOS_PER_SECOND = 1000000000;
+
+    Timestamp seconds = timestamp / NANOS_PER_SECOND;
+    Timestamp nanos = timestamp % NANOS_PER_SECOND;
+    if (nanos < 0)
+    {
+        nanos += NANOS_PER_SECOND;
+        --seconds;
+    }
+
+    const std::time_t time = static_cast<std::time_t>(seconds);
     std::tm timeStruct;
 
 #ifdef _WIN32
-    localtime_s(&timeStruct, &now);
+    gmtime_s(&timeStruct, &time);
 #else
-    localtime_r(&now, &timeStruct);
+    gmtime_r(&time, &timeStruct);
 #endif
 
-    // Формат ISO 8601
-    std::stringstream ss;
-    ss << std::put_time(&timeStruct, "%Y-%m-%d %H:%M:%S");
-    return ss.str();
+    char buffer[48];
+    const size_t length = std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%S", &timeStruct);
+    std::snprintf(buffer + length, sizeof(buffer) - length, ".%09lldZ", static_cast<long long>(nanos));
+    return buffer;
 }
 
 // Реализация методов Validator
@@ -132,51 +168,45 @@ bool Validator::isAddressFormatValid(const std::string &address)
 
 std::string PersistenceManager::encryptString(const std::string &plaintext, const std::string &key)
 {   
-    // Создаем контекст для шифрования
-    EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
+    // Контекст шифрования потока переиспользуется между вызовами
+    CryptoContexts::CipherLease lease;
+    EVP_CIPHER_CTX *ctx = lease.get();
     if (!ctx) {
         throw std::runtime_error("Failed to create encryption context");
     }
 
-    // Выбираем алгоритм шифрования AES-256-CBC
-    const EVP_CIPHER *cipher = EVP_aes_256_cbc();
+    // Алгоритм AES-256-CBC извлекается из провайдера один раз
+    const EVP_CIPHER *cipher = CryptoContexts::aes256Cbc();
 
     // Генерируем случайный вектор инициализации (IV)
     int iv_length = EVP_CIPHER_iv_length(cipher);
     unsigned char iv[EVP_MAX_IV_LENGTH];
     RAND_bytes(iv, iv_length);
 
-    // Вычисляем размер буфера для зашифрованного текста
-    int ciphertext_len = static_cast<int>(plaintext.size()) + EVP_CIPHER_block_size(cipher);
-    std::vector<unsigned char> ciphertext(ciphertext_len);
+    // Результат: IV + зашифрованный текст, записывается сразу в выходную строку
+    const int block_size = EVP_CIPHER_block_size(cipher);
+    std::string result(static_cast<size_t>(iv_length) + plaintext.size() + block_size, '\0');
+    std::memcpy(result.data(), iv, iv_length);
+    unsigned char *ciphertext = reinterpret_cast<unsigned char *>(result.data()) + iv_length;
     
     // Инициализируем шифрование
     if (EVP_EncryptInit_ex(ctx, cipher, NULL, reinterpret_cast<const unsigned char *>(key.data()), iv) != 1) {
-        EVP_CIPHER_CTX_free(ctx);
         throw std::runtime_error("Encryption initialization failed");
     }
 
     // Шифруем данные
     int len;
-    if (EVP_EncryptUpdate(ctx, ciphertext.data(), &len, reinterpret_cast<const unsigned char *>(plaintext.data()), static_cast<int>(plaintext.size())) != 1) {
-        EVP_CIPHER_CTX_free(ctx);
+    if (EVP_EncryptUpdate(ctx, ciphertext, &len, reinterpret_cast<const unsigned char *>(plaintext.data()), static_cast<int>(plaintext.size())) != 1) {
         throw std::runtime_error("Encryption update failed");
     }
     int total_len = len;
 
     // Завершаем шифрование
-    if (EVP_EncryptFinal_ex(ctx, ciphertext.data() + len, &len) != 1) {
-        EVP_CIPHER_CTX_free(ctx);
+    if (EVP_EncryptFinal_ex(ctx, ciphertext + len, &len) != 1) {
         throw std::runtime_error("Encryption finalization failed");
     }
     total_len += len;
 
-    // Освобождаем контекст шифрования
-    EVP_CIPHER_CTX_free(ctx);
-
-    // Формируем результат: IV + зашифрованный текст
-    std::string result(reinterpret_cast<char *>(iv), iv_length);
-    result.append(reinterpret_cast<char *>(ciphertext.data()), total_len);
-
+    result.resize(static_cast<size_t>(iv_length) + total_len);
     return result;
 }
@@ -0,0 +1,143 @@
+// BC_ValidationPool.cpp
+#include "BC_ValidationPool.h"
+#include "BC_MiningScheduler.h"
+#include "BC_Utilities.h"
+
+// Системные библиотеки (только для реализации)
+#include <string>
+#include <algorithm>
+
+ValidationPool::ValidationPool(unsigned int workerCount, bool pinThreads)
+{
+    const unsigned int hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    workers.reserve(workerCount);
+    for (unsigned int i = 0; i < workerCount; ++i)
+    {
+        workers.emplace_back(&ValidationPool::workerLoop, this);
+
+        if (pinThreads && !MiningScheduler::pinToCore(workers.back(), i % hardwareThreads))
+        {
+            ConsoleUI::printWarning("Failed to pin validation worker " + std::to_string(i) +
+                                    " to core " + std::to_string(i % hardwareThreads));
+        }
+    }
+}
+
+ValidationPool::~ValidationPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        stopping = true;
+    }
+    batchReady.notify_all();
+
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+}
+
+void ValidationPool::parallelFor(size_t itemCount, const std::function<void(size_t)> &itemBody)
+{
+    // Мелкие пакеты не стоят пробуждения рабочих потоков
+    if (workers.empty() || itemCount < 2)
+    {
+        for (size_t i = 0; i < itemCount; ++i)
+        {
+            itemBody(i);
+        }
+        return;
+    }
+
+    // Между порциями пул достается ожидающим пакетам других потоков
+    for (size_t first = 0; first < itemCount; first += CHUNK_SIZE)
+    {
+        runChunk(first, std::min(itemCount, first + CHUNK_SIZE), itemBody);
+    }
+}
+
+void ValidationPool::runChunk(size_t first, size_t last, const std::function<void(size_t)> &itemBody)
+{
+    {
+        std::unique_lock<std::mutex> lock(stateMutex);
+        const uint64_t ticket = nextTicket++;
+        turnReady.wait(lock, [&]()
+                       { return servingTicket == ticket; });
+        body = &itemBody;
+        count = last;
+        nextIndex.store(first, std::memory_order_relaxed);
+        failure = nullptr;
+        busyWorkers = static_cast<unsigned int>(workers.size());
+        ++generation;
+    }
+    batchReady.notify_all();
+
+    // Вызывающий поток обрабатывает пакет вместе с рабочими
+    drain();
+
+    std::exception_ptr batchFailure;
+    {
+        // Пакет живет на стеке вызывающего: ждем, пока все рабочие его покинут
+        std::unique_lock<std::mutex> lock(stateMutex);
+        batchDone.wait(lock, [this]()
+                       { return busyWorkers == 0; });
+        body = nullptr;
+        batchFailure = failure;
+        ++servingTicket;
+    }
+    turnReady.notify_all();
+
+    if (batchFailure)
+        std::rethrow_exception(batchFailure);
+}
+
+unsigned int ValidationPool::getWorkerCount() const
+{
+    return static_cast<unsigned int>(workers.size());
+}
+
+void ValidationPool::workerLoop()
+{
+    uint64_t seenGeneration = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(stateMutex);
+            batchReady.wait(lock, [&]()
+                            { return stopping || generation != seenGeneration; });
+            if (stopping)
+                return;
+            seenGeneration = generation;
+        }
+
+        drain();
+
+        bool lastWorker = false;
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            lastWorker = (--busyWorkers == 0);
+        }
+        if (lastWorker)
+            batchDone.notify_one();
+    }
+}
+
+void ValidationPool::drain()
+{
+    for (size_t i = nextIndex.fetch_add(1, std::memory_order_relaxed); i < count;
+         i = nextIndex.fetch_add(1, std::memory_order_relaxed))
+    {
+        try
+        {
+            (*body)(i);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            if (!failure)
+                failure = std::current_exception();
+        }
+    }
+}
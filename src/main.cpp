@@ -4,7 +4,6 @@
 #include <iostream>
 #include <string>
 #include <vector>
-#include <map>
 #include <fstream>
 
 
@@ -14,11 +13,97 @@
 #include "BC_Controller.h"    // Управление блокчейном
 #include "BC_KeyManager.h"    // Управление ключами пользователей
 #include "BC_Utilities.h"     // Вспомогательные функции и утилиты
+#include "BC_MiningScheduler.h" // Пул потоков майнинга
+#include "BC_SignatureScheme.h" // Схемы цифровой подписи
+#include "BC_Mempool.h"       // Пул транзакций
 
 
-int main()
+// Параметры запуска
+struct StartupOptions
+{
+    MiningScheduler::Config mining;                                                 // Пул майнинга
+    Mempool::Config mempool;                                                        // Лимиты пула транзакций
+    SignatureScheme::Algorithm signatureAlgorithm = SignatureScheme::Algorithm::RSA2048; // Схема новых ключей
+    bool fullVerification = false;                                                  // Валидация без кеша подписей
+};
+
+// Разбор параметров командной строки:
+//   --miners N                 количество потоков майнинга
+//   --reserve-cores N          ядра, оставляемые для валидации
+//   --pin-miners               закрепить потоки майнинга за ядрами
+//   --mining-stats N           печатать скорость хеширования каждые N секунд
+//   --signature-scheme NAME    схема подписи новых ключей: rsa2048, ed25519, p256
+//   --full-verify              при валидации цепочки проверять все подписи заново
+//   --block-size N             запечатывать блок при N транзакциях в пуле
+//   --block-interval-ms N      запечатывать блок, когда старейшая транзакция ждет N мс
+//   --pending-expiry-ms N      удалять неоплачиваемую транзакцию, ждущую дольше N мс
+StartupOptions parseStartupOptions(int argc, char *argv[])
+{
+    StartupOptions options;
+    MiningScheduler::Config &config = options.mining;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        try
+        {
+            if (arg == "--miners" && i + 1 < argc)
+            {
+                config.workerCount = static_cast<unsigned int>(std::stoul(argv[++i]));
+            }
+            else if (arg == "--reserve-cores" && i + 1 < argc)
+            {
+                config.reservedCores = static_cast<unsigned int>(std::stoul(argv[++i]));
+            }
+            else if (arg == "--pin-miners")
+            {
+                config.pinThreads = true;
+            }
+            else if (arg == "--mining-stats" && i + 1 < argc)
+            {
+                config.statsIntervalMs = static_cast<unsigned int>(std::stoul(argv[++i])) * 1000;
+            }
+            else if (arg == "--signature-scheme" && i + 1 < argc)
+            {
+                const SignatureScheme *scheme = SignatureScheme::fromName(argv[++i]);
+                if (scheme)
+                    options.signatureAlgorithm = scheme->algorithm();
+                else
+                    ConsoleUI::printWarning("Unknown signature scheme ignored: " + std::string(argv[i]));
+            }
+            else if (arg == "--full-verify")
+            {
+                options.fullVerification = true;
+            }
+            else if (arg == "--block-size" && i + 1 < argc)
+            {
+                options.mempool.maxBlockTransactions = std::stoul(argv[++i]);
+            }
+            else if (arg == "--block-interval-ms" && i + 1 < argc)
+            {
+                options.mempool.maxBlockDelayMs = static_cast<unsigned int>(std::stoul(argv[++i]));
+            }
+            else if (arg == "--pending-expiry-ms" && i + 1 < argc)
+            {
+                options.mempool.maxPendingMs = static_cast<unsigned int>(std::stoul(argv[++i]));
+            }
+            else
+            {
+                ConsoleUI::printWarning("Unknown option ignored: " + arg);
+            }
+        }
+        catch (const std::exception &)
+        {
+            ConsoleUI::printWarning("Invalid value for option: " + arg);
+        }
+    }
+    return options;
+}
+
+
+int main(int argc, char *argv[])
 {
     ConsoleUI::printBanner();
+    const StartupOptions options = parseStartupOptions(argc, argv);
 
     // Инициализация Genesis пользователя
     std::vector<std::string> users = {"Genesis_User"};
@@ -28,12 +113,12 @@ int main()
     ConsoleUI::printInfo("Logged in as: " + currentUser);
 
     // Инициализация ключей
-    KeyManager keyManager(users);
+    KeyManager keyManager(users, options.signatureAlgorithm);
 
     // Инициализация блокчейна
     ConsoleUI::printSectionHeader("Genesis Block Creation");
     ConsoleUI::printInfo("Mining genesis block...\n");
-    BlockchainController controller(keyManager.getPublicKeys());
+    BlockchainController controller(keyManager.getPublicKeyCache(), options.mining, options.mempool);
     ConsoleUI::printSuccess("Genesis block created successfully!");
 
     // Главный цикл
@@ -79,9 +164,11 @@ int main()
                 ConsoleUI::printWarning("No users registered yet");
                 break;
             }
-            for (const auto &[user, key] : menu_users)
+            // Таблица ключей не упорядочена: имена сортируются только для вывода
+            for (const std::string_view user : menu_users.sortedKeys())
             {
-                ConsoleUI::printDefault(" - " + user + " (balance: " + std::to_string(controller.getUserBalance(user)) + ")");
+                const std::string name(user);
+                ConsoleUI::printDefault(" - " + name + " (balance: " + AmountUtils::format(controller.getUserBalance(name)) + ")");
             }
             break;
         }
@@ -93,12 +180,12 @@ int main()
             std::string user;
             std::cin >> user;
 
-            if (keyManager.getPublicKeys().count(user))
+            if (keyManager.getPublicKeys().contains(user))
             {
                 currentUser = user;
-                double balance = controller.getUserBalance(currentUser);
+                const Amount balance = controller.getUserBalance(currentUser);
                 ConsoleUI::printSuccess("Logged in as: " + currentUser);
-                ConsoleUI::printInfo("Current balance: " + std::to_string(balance));
+                ConsoleUI::printInfo("Current balance: " + AmountUtils::format(balance));
             }
             else
             {
@@ -125,20 +212,21 @@ int main()
 
             // Ввод суммы
             ConsoleUI::printDefault("Amount to send: ", false);
-            double amount;
-            if (!(std::cin >> amount))
+            std::string amountText;
+            Amount amount = 0;
+            if (!(std::cin >> amountText) || !AmountUtils::parse(amountText, amount))
             {
-                ConsoleUI::printError("Invalid amount format");
+                ConsoleUI::printError("Invalid amount format (up to " + std::to_string(AmountUtils::DECIMALS) + " decimal places)");
                 std::cin.clear();
                 std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
                 break;
             }
 
             // Проверка баланса
-            double balance = controller.getUserBalance(currentUser);
+            const Amount balance = controller.getUserBalance(currentUser);
             if (amount > balance)
             {
-                ConsoleUI::printError("Insufficient funds. Available: " + std::to_string(balance));
+                ConsoleUI::printError("Insufficient funds. Available: " + AmountUtils::format(balance));
                 break;
             }
 
@@ -184,10 +272,13 @@ int main()
                 ConsoleUI::printDefault(
                     " - Sender:    " + tx.getSender() + "\n" +
                     " - Receiver:  " + tx.getReceiver() + "\n" +
-                    " - Amount:    " + std::to_string(tx.getAmount()) + "\n" +
-                    " - TX ID:     " + tx.getTxId().substr(0, 12) + "...\n");
+                    " - Amount:    " + AmountUtils::format(tx.getAmount()) + "\n" +
+                    " - TX ID:     " + tx.getTxId().toHex().substr(0, 12) + "...\n");
 
-                controller.processTransactions({tx});
+                if (controller.submitTransaction(std::move(tx)))
+                {
+                    ConsoleUI::printInfo("Transaction added to mempool, it will be mined with the next block");
+                }
             }
             catch (const std::exception &e)
             {
@@ -214,7 +305,7 @@ int main()
         case 7:
         { // Валидация
             ConsoleUI::printSectionHeader("Blockchain Validation");
-            if (controller.isBlockchainValid())
+            if (controller.isBlockchainValid(options.fullVerification))
             {
                 ConsoleUI::printSuccess("Blockchain integrity verified!");
             }
@@ -227,6 +318,14 @@ int main()
 
         case 8: // Выход
             running = false;
+            if (controller.getPendingTransactionCount() > 0)
+            {
+                ConsoleUI::printInfo("Waiting for pending transactions to be mined...");
+                controller.waitForPendingBlocks();
+                if (controller.getPendingTransactionCount() > 0)
+                    ConsoleUI::printWarning(std::to_string(controller.getPendingTransactionCount()) +
+                                            " unaffordable transactions discarded");
+            }
             ConsoleUI::printSectionHeader("System Shutdown");
             ConsoleUI::printInfo("Thank you for using Base Blockchain Transaction System!");
             break;